@@ -4,6 +4,8 @@
 // Author:    Aiko Pras
 // History:   2021/06/27 AP Version 1.0
 //            2021/12/30 AP Version 1.2
+//            2026/10/18 AP Version 1.3 No delays during start-up
+//            2026/10/18 AP Version 1.4 Reports the first feedback answer (decoderHardware.answerTime)
 //
 // Purpose:   DCC Accessory decoder skeleton. Includes RS-Bus feedback and Configuration Variables (CVs)
 //            Glues together all common objects, including DCC message processing, RS-Bus feedback,  
@@ -30,12 +32,10 @@ uint8_t feedbackData = 0;            // The (initial) value we will send over th
 //******************************************************************************************************
 void setup() {
   // Serial monitor is used for debugging
-  delay(100);
+  // Note that delays in setup() postpone the moment the decoder answers RS-Bus polls
   Serial.begin(115200);
-  delay(100);
   Serial.println();
   Serial.println("Start");
-  delay(100);
   //
   // Step 1: Set CV default values (see CvValues.h. for details) 
   // Decoder type (DecType) and software version (version) are set using cvValues.init().
@@ -132,7 +132,11 @@ void loop() {
   // As frequent as possible we should check if the RS-Bus asks for the most recent feedback data.
   // This is the case after a decoder restart or after a RS-Bus error. In addition we have to 
   // check if the buffer contains feedback data, and the ISR is ready to send that data via the UART.  
-  if (rsbus.feedbackRequested) rsbus.send8bits(feedbackData);
+  // feedbackAnswered() records when the first answer was queued (start-up metric answerTime).
+  if (rsbus.feedbackRequested) {
+    rsbus.send8bits(feedbackData);
+    decoderHardware.feedbackAnswered();
+  }
   rsbus.checkConnection();
   //
   // Step 4: as frequent as possible we should update the RS-Bus hardware, check if the programming
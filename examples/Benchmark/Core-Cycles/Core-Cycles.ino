@@ -0,0 +1,195 @@
+//******************************************************************************************************
+//
+// File:      Core-Cycles.ino
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//            2026/10/18 AP Version 1.1 Baselines for the UNO, timer usage notes
+//            2026/10/18 AP Version 1.2 No baselines till a reference run has been made
+//
+// Purpose:   Measures the number of CPU clock cycles of the hot paths of the decoder core, on the
+//            actual board:
+//            - decoderHardware.update()
+//            - FlashLed::update()
+//            - DccTimer::expired()
+//            - cvValues.storedAddress()
+//            - cvProgramming.processMessage() (SM verify byte, thus without EEPROM write)
+//
+// The cycles are counted by a 16 bit hardware timer that runs at the CPU clock:
+// - Traditional ATMega processors (328, 2560, 16): Timer1, prescaler 1
+// - MegaAVR (4808, 4809) and DA/DB processors: TCB1, CLK_PER. If TCB1 is used by another
+//   library, change cycleTCB below.
+// - Other processors: micros(), converted into cycles (resolution 4us on a 16MHz UNO)
+//
+// Usage notes:
+// - This sketch takes over Timer1 (ATMega) or TCB1 (MegaAVR, DA/DB) completely: it changes the
+//   mode and the prescaler of the timer. On the UNO, Timer1 is also used by the Servo library,
+//   for analogWrite() on pins 9 and 10, and by DccOneShot (if DCC_CORE_ONESHOT is set). These
+//   do not work correctly while this sketch runs, and this sketch should not be merged into a
+//   decoder sketch. On the Nano Every, TCB1 may be used by the Servo and Tone libraries.
+// - The DCC and RS-Bus interfaces are attached, but need not be connected.
+// Each function is called `runs` times via a function pointer; the cost of calling an empty
+// function in the same way is subtracted. The minimum, average and maximum number of cycles per
+// call are printed. Interrupts remain enabled, so the maximum includes interrupts (DCC, RS-Bus,
+// millis); the minimum is the most reproducible number.
+//
+// Flash and RAM usage per path are not measured. The Arduino IDE (or arduino-cli) only reports
+// the totals of the complete sketch after compilation.
+//
+// Regressions: runs print "REGRESSION" if a function needs more than 10% extra cycles than its
+// baseline. Baselines are specific for a processor and clock speed, and are therefore kept per
+// board (see baselines below). After each run, the sketch prints the averages as a baseline line,
+// which may be copied into the table of the board after a reference run. A baseline of 0 is not
+// checked. No reference runs have been made yet, so all baselines are still 0.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DCC_Decoder_Core.h>
+
+const uint16_t runs = 1000;
+
+
+//******************************************************************************************************
+// Cycle counter
+//******************************************************************************************************
+#if defined(TCCR1B)
+void counterInit() {
+  TCCR1A = 0;
+  TCCR1B = (1 << CS10);                       // Normal mode, prescaler 1
+}
+inline uint16_t counter() {return TCNT1;}
+
+#elif defined(TCB1)
+#define cycleTCB TCB1
+void counterInit() {
+  cycleTCB.CTRLA = 0;
+  cycleTCB.CTRLB = TCB_CNTMODE_INT_gc;        // Periodic interrupt mode, without interrupt
+  cycleTCB.CCMP = 0xFFFF;
+  cycleTCB.CNT = 0;
+  cycleTCB.CTRLA = TCB_ENABLE_bm;             // Clock: CLK_PER (no prescaler)
+}
+inline uint16_t counter() {return cycleTCB.CNT;}
+
+#else
+void counterInit() {}
+inline uint16_t counter() {return micros() * (F_CPU / 1000000UL);}
+#endif
+
+
+//******************************************************************************************************
+// The functions to measure
+//******************************************************************************************************
+FlashLed led;
+DccTimer timer;
+
+void emptyFunction() {}
+void hwUpdate() {decoderHardware.update();}
+void ledUpdate() {led.update();}
+void timerExpired() {timer.expired();}
+void storedAddress() {cvValues.storedAddress();}
+void processMessage() {
+  cvCmd.operation = CvAccess::verifyByte;
+  cvCmd.number = VID;
+  cvCmd.value = cvValues.read(VID) + 1;       // No match, thus no DCC-Ack
+  cvProgramming.processMessage(Dcc::SmCmd);
+}
+
+//******************************************************************************************************
+// Baselines: average cycles per call of a reference run, in the order of benchmark[] below.
+// 0: not checked. Paste the baseline line printed by a reference run into the table of the board,
+// for example for the UNO (ATmega328P, 16MHz) with the default core_features.h.
+//******************************************************************************************************
+#if defined(__AVR_ATmega328P__) && (F_CPU == 16000000UL)
+const uint16_t baselines[] = {0, 0, 0, 0, 0};   // No reference run yet
+#else
+const uint16_t baselines[] = {0, 0, 0, 0, 0};
+#endif
+
+
+struct benchmark_t {
+  const char *name;
+  void (*function)();
+};
+
+benchmark_t benchmark[] = {
+  {"decoderHardware.update()", hwUpdate},
+  {"FlashLed::update()", ledUpdate},
+  {"DccTimer::expired()", timerExpired},
+  {"cvValues.storedAddress()", storedAddress},
+  {"processMessage(SM verify)", processMessage},
+};
+const uint8_t numberOfBenchmarks = sizeof(benchmark) / sizeof(benchmark[0]);
+static_assert(sizeof(baselines) / sizeof(baselines[0]) == numberOfBenchmarks,
+              "One baseline per benchmark");
+
+
+//******************************************************************************************************
+uint16_t overhead;
+
+void measure(void (*function)(), uint16_t &minimum, uint32_t &total, uint16_t &maximum) {
+  minimum = 0xFFFF;
+  maximum = 0;
+  total = 0;
+  for (uint16_t i = 0; i < runs; i++) {
+    uint16_t start = counter();
+    function();
+    uint16_t cycles = counter() - start;
+    cycles = (cycles > overhead) ? cycles - overhead : 0;
+    if (cycles < minimum) minimum = cycles;
+    if (cycles > maximum) maximum = cycles;
+    total += cycles;
+  }
+}
+
+
+void setup() {
+  Serial.begin(115200);
+  delay(100);
+  cvValues.init(SwitchDecoder, 10);
+  decoderHardware.init();
+  led.attach(LED_BUILTIN);
+  led.flashSlow();
+  timer.setTime(1000);
+  counterInit();
+  // Determine the overhead of the measurement itself
+  uint16_t minimum, maximum;
+  uint32_t total;
+  overhead = 0;
+  measure(emptyFunction, minimum, total, maximum);
+  overhead = minimum;
+  Serial.print("F_CPU: ");
+  Serial.print(F_CPU);
+  Serial.print(" - measurement overhead: ");
+  Serial.print(overhead);
+  Serial.println(" cycles");
+}
+
+
+void loop() {
+  uint16_t average[numberOfBenchmarks];
+  for (uint8_t i = 0; i < numberOfBenchmarks; i++) {
+    uint16_t minimum, maximum;
+    uint32_t total;
+    measure(benchmark[i].function, minimum, total, maximum);
+    average[i] = total / runs;
+    Serial.print(benchmark[i].name);
+    Serial.print(": min = ");
+    Serial.print(minimum);
+    Serial.print(", avg = ");
+    Serial.print(average[i]);
+    Serial.print(", max = ");
+    Serial.print(maximum);
+    Serial.print(" cycles");
+    uint16_t baseline = baselines[i];
+    if (baseline && (average[i] > baseline + (baseline / 10))) Serial.print("  REGRESSION");
+    Serial.println();
+  }
+  // The averages of this run, in the format of the baselines table
+  Serial.print("const uint16_t baselines[] = {");
+  for (uint8_t i = 0; i < numberOfBenchmarks; i++) {
+    if (i) Serial.print(", ");
+    Serial.print(average[i]);
+  }
+  Serial.println("};");
+  Serial.println();
+  delay(5000);
+}
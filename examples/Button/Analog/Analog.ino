@@ -0,0 +1,38 @@
+//******************************************************************************************************
+//
+// Test sketch for the AP_DccAnalogButtons library
+// Four buttons are connected via a resistor ladder to A0. Each press prints the button number,
+// together with the ADC value, which helps to determine the values for the classification table.
+//
+// 2026/10/18 AP
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DccAnalogButtons.h>
+
+// Upper bound of the (8 bit) ADC values per button. No button pressed gives 255
+const uint8_t limits[] = {30, 90, 160, 220};
+
+DccAnalogButtons panel;
+
+
+void setup() {
+  Serial.begin(115200);
+  panel.attach(A0, limits, 4);
+}
+
+
+void loop() {
+  panel.read();
+  for (uint8_t i = 0; i < 4; i++) {
+    if (panel.wasPressed(i)) {
+      Serial.print("Button: ");
+      Serial.print(i);
+      Serial.print(" - ADC value: ");
+      Serial.println(panel.lastValue());
+    }
+    if (panel.pressedFor(i, 2000)) {
+      // button i is pressed for 2 seconds
+    }
+  }
+}
@@ -0,0 +1,31 @@
+//******************************************************************************************************
+//
+// Test sketch for the AP_DccButtonBank library
+// Eight buttons, connected between Port C and ground, are read as a single bank.
+// A short press of a button toggles the onboard LED. A long press (2 seconds) lets the LED flash.
+//
+// 2026/10/18 AP
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DccButtonBank.h>
+#include <AP_DccLED.h>
+
+DccButtonBank panel;
+FlashLed led;
+
+void setup() {
+  led.attach(LED_BUILTIN);
+  for (uint8_t pin = PIN_PC0; pin <= PIN_PC7; pin++) panel.attach(pin);
+  panel.setTimes(5, 2000);                    // Sample every 5ms, long press after 2 seconds
+}
+
+void loop() {
+  panel.read();
+  if (panel.pressedEdges(0)) {
+    if (led.ledIsOn()) led.turn_off();
+    else led.turn_on();
+  }
+  if (panel.longEdges(0)) led.flashFast();
+  led.update();
+}
@@ -0,0 +1,33 @@
+//******************************************************************************************************
+//
+// Test sketch for the AP_DccIrqButton library
+// A toggle button switches the LED on or off. To show that presses are not missed if the main
+// loop is busy, the loop contains a (deliberately long) delay.
+// Wire the switch from an interrupt capable Arduino pin to ground.
+//
+// 2026/10/18 AP
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DccIrqButton.h>
+
+const uint8_t buttonPin = 2;               // On an UNO only pin 2 and 3 can be used
+const uint8_t ledPin = LED_BUILTIN;
+
+IrqToggleButton myButton;
+
+
+void setup() {
+  pinMode(ledPin, OUTPUT);
+  if (!myButton.attach(buttonPin)) {
+    // This pin does not support interrupts: keep the LED on
+    digitalWrite(ledPin, HIGH);
+    while (true) {};
+  }
+}
+
+
+void loop() {
+  digitalWrite(ledPin, myButton.toggleState());
+  delay(500);                              // Simulates a busy main loop
+}
@@ -0,0 +1,48 @@
+//******************************************************************************************************
+//
+// Test sketch for the AP_DccCoilScheduler library
+// 2026/10/18 AP
+//
+// Every 5 seconds a "route" sets all eight relays to the other position. The scheduler ensures
+// that no more than two coils are active at the same time, and that there is at least 50ms
+// between switching off a coil and activating the next one. Relays 1 and 2 have a higher
+// priority, and are therefore switched first.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DccRelay.h>
+#include <AP_DccCoilScheduler.h>
+
+const uint8_t numberOfRelays = 8;
+const uint8_t pinPos1[numberOfRelays] = {2, 4, 6, 8, 10, 12, 14, 16};
+const uint8_t pinPos2[numberOfRelays] = {3, 5, 7, 9, 11, 13, 15, 17};
+
+#define HOLD_TIME      3  // 3 * 20ms = 60ms
+#define MAX_ACTIVE     2
+#define RECHARGE      50  // ms
+
+relayClass relay[numberOfRelays];
+DccCoilScheduler coils;
+long tLast;
+
+
+void setup() {
+  coils.attach(MAX_ACTIVE, RECHARGE, DccCoilScheduler::priority);
+  for (uint8_t i = 0; i < numberOfRelays; i++) {
+    relay[i].init(pinPos1[i], pinPos2[i], HOLD_TIME);
+    relay[i].useScheduler(&coils, (i < 2) ? 1 : 0);
+  }
+}
+
+
+void loop() {
+  if ((millis() - tLast) > 5000) {
+    tLast = millis();
+    for (uint8_t i = 0; i < numberOfRelays; i++) {
+      if (relay[i].state == relayClass::POS1) relay[i].activate(relayClass::POS2);
+      else relay[i].activate(relayClass::POS1);    // If UNKNOWN or POS2
+    }
+  }
+  for (uint8_t i = 0; i < numberOfRelays; i++) relay[i].update();
+  coils.update();
+}
@@ -0,0 +1,45 @@
+//******************************************************************************************************
+//
+// Test sketch for DccCvSerial
+// 2026/10/18 AP
+//
+// A switch decoder skeleton of which the CVs can be read and written via the USB serial port, next
+// to PoM and SM. Use extras/cvtool.py to save the CVs into a profile, or to write a profile:
+//
+//   python3 extras/cvtool.py read  /dev/ttyUSB0 switch.txt
+//   python3 extras/cvtool.py write /dev/ttyUSB0 switch.txt
+//
+// The sketch should not print text on the same serial port.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DCC_Decoder_Core.h>
+#include <AP_DccCvSerial.h>
+
+DccCvSerial cvSerial;
+
+
+void setup() {
+  Serial.begin(115200);
+  cvSerial.attach(Serial);
+  cvValues.init(SwitchDecoder, 20);
+  decoderHardware.init();
+}
+
+
+void loop() {
+  if (dcc.input()) {
+    switch (dcc.cmdType) {
+      case Dcc::MyPomCmd :
+        cvProgramming.processMessage(Dcc::MyPomCmd);
+      break;
+      case Dcc::SmCmd :
+        cvProgramming.processMessage(Dcc::SmCmd);
+      break;
+      default:
+      break;
+    }
+  }
+  decoderHardware.update();
+  cvSerial.update();
+}
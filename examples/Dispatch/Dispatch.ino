@@ -0,0 +1,66 @@
+//******************************************************************************************************
+//
+// Test sketch for DccDispatcher
+// 2026/10/18 AP
+//
+// A decoder with two accessory decoder addresses, or eight output addresses (8 outputs). Outputs 0..3 control LEDs on pins 4..7 via
+// basic accessory commands; outputs 4..7 print the aspect of extended accessory commands. The
+// handlers are listed in a static table, so loop() no longer contains a switch on dcc.cmdType.
+// Every 10 seconds the number of commands per output is printed.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DCC_Decoder_Core.h>
+
+const uint8_t ledPins[4] = {4, 5, 6, 7};
+
+
+void led(uint8_t index, uint8_t position, bool activate) {
+  if (activate) digitalWrite(ledPins[index], position);
+}
+
+
+void signal(uint8_t index, uint8_t aspect, bool activate) {
+  Serial.print("Output ");
+  Serial.print(index);
+  Serial.print(" - aspect ");
+  Serial.println(aspect);
+}
+
+
+DccOutputSlot outputs[8] = {
+  {led, 0, 0},
+  {led, 0, 0},
+  {led, 0, 0},
+  {led, 0, 0},
+  {0, signal, 0},
+  {0, signal, 0},
+  {0, signal, 0},
+  {0, signal, 0}
+};
+
+DccTimer statisticsTimer;
+
+
+void setup() {
+  Serial.begin(115200);
+  for (uint8_t i = 0; i < 4; i++) pinMode(ledPins[i], OUTPUT);
+  cvValues.init(SwitchDecoder, 20);
+  decoderHardware.init();
+  decoderAddresses.setRange(bitRead(cvValues.read(Config), 6) ? 8 : 2);   // 8 outputs
+  commandDispatcher.attach(outputs, 8);
+  statisticsTimer.setTime(10000);
+}
+
+
+void loop() {
+  decoderHardware.update();           // Also dispatches the DCC commands
+  if (statisticsTimer.expired()) {
+    statisticsTimer.start();
+    for (uint8_t i = 0; i < 8; i++) {
+      Serial.print(commandDispatcher.commands(i));
+      Serial.print(" ");
+    }
+    Serial.println();
+  }
+}
@@ -0,0 +1,36 @@
+//******************************************************************************************************
+//
+// Test sketch for the AP_DccRelayBank library
+// 2026/10/18 AP
+//
+// Relays 1-8 are connected to Port C, relays 9-16 to Port A (as on the Relays-16 decoder).
+// Every second the next relay is switched on for 300ms; every 16 seconds all relays are
+// switched on together for 100ms.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DccRelayBank.h>
+
+#define RELAY_1       PIN_PC0
+#define RELAY_9       PIN_PA0
+#define ACTIVE_HIGH   true    // Value of the Ract CV
+
+DccRelayBank relays;
+uint8_t relay;
+long tLast;
+
+
+void setup() {
+  relays.attach(RELAY_1, RELAY_9, ACTIVE_HIGH);
+}
+
+
+void loop() {
+  if ((millis() - tLast) > 1000) {
+    tLast = millis();
+    relays.pulse(1 << relay, 300);
+    relay = (relay + 1) % 16;
+    if (relay == 0) relays.pulse(0xFFFF, 100);
+  }
+  relays.update();
+}
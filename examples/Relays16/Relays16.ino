@@ -0,0 +1,73 @@
+//******************************************************************************************************
+//
+// File:      Relays16.ino
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//            2026/10/18 AP Version 1.1 Uses decoderAddresses
+//            2026/10/18 AP Version 1.2 Uses rsFeedback
+//            2026/10/18 AP Version 1.3 Sixteen addresses if output addressing is used (CV29 bit 6)
+//            2026/10/18 AP Version 1.4 The position of the command switches the relay on or off
+//
+// Purpose:   Skeleton for the Relays-16 decoder. Relays 1-8 are connected to Port C, relays 9-16
+//            to Port A. The operating mode (0..3), the round-robin relays and interval, as well as
+//            the relay polarity are taken from the Mode, RRR1, RRR2, RInter and Ract CVs.
+//
+// The decoder listens to four consecutive accessory decoder addresses, starting with the address
+// stored in the CVs. Each turnout of these addresses controls one relay. With output addressing
+// (CV29 bit 6), the decoder listens to sixteen consecutive output addresses instead. The position
+// of the command (+ or -) switches the relay on or off; deactivate commands are ignored. Each state change of the
+// relays is sent as feedback via two RS-Bus addresses (relays 1-8 and relays 9-16). In round-robin
+// mode the relays change rapidly; rsFeedback only sends the latest state of each address.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DCC_Decoder_Core.h>
+#include <AP_DccRelayBank.h>
+
+DccRelayBank relays;
+DccRoundRobin engine;
+DccFeedbackSlot feedbackSlots[2];    // Feedback for relays 1-8 and relays 9-16
+
+
+void relaysChanged(uint16_t state, uint16_t changed) {
+  rsFeedback.set(0, state & 0xFF);
+  rsFeedback.set(1, state >> 8);
+}
+
+
+void setup() {
+  cvValues.init(Relays16Decoder, 10);
+  decoderHardware.init();
+  // Decoder addressing: 4 addresses of 4 turnouts each. Output addressing: 16 addresses
+  decoderAddresses.setRange(bitRead(cvValues.read(Config), 6) ? 16 : 4);
+  rsFeedback.attach(feedbackSlots, 2, cvValues.read(myRSAddr));
+  relays.attach(PIN_PC0, PIN_PA0, cvValues.read(Ract));
+  uint16_t rrMask = cvValues.read(RRR1) | (cvValues.read(RRR2) << 8);
+  engine.attach(&relays, cvValues.read(Mode), rrMask, cvValues.read(RInter), relaysChanged);
+  relaysChanged(relays.state(), 0xFFFF);     // Initial feedback state
+}
+
+
+void loop() {
+  if (dcc.input()) {
+    switch (dcc.cmdType) {
+      case Dcc::MyAccessoryCmd :
+      case Dcc::AnyAccessoryCmd :
+        if (accCmd.activate && decoderAddresses.match()) {
+          engine.command(decoderAddresses.index, accCmd.position);
+        }
+      break;
+      case Dcc::MyPomCmd :
+        cvProgramming.processMessage(Dcc::MyPomCmd);
+      break;
+      case Dcc::SmCmd :
+        cvProgramming.processMessage(Dcc::SmCmd);
+      break;
+      default:
+      break;
+    }
+  }
+  engine.update();
+  relays.update();
+  decoderHardware.update();
+}
@@ -0,0 +1,52 @@
+//******************************************************************************************************
+//
+// Test sketch for the AP_DccStateStore library
+// 2026/10/18 AP
+//
+// Four relays store their position in the last 100 bytes of the EEPROM. After a reboot the
+// restored positions are printed. Every 3 seconds a relay is switched to the other position; reset
+// the board to check that the positions are restored.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DccRelay.h>
+#include <AP_DccStateStore.h>
+
+const uint8_t numberOfRelays = 4;
+const uint8_t pinPos1[numberOfRelays] = {4, 6, 8, 10};
+const uint8_t pinPos2[numberOfRelays] = {5, 7, 9, 11};
+
+#define HOLD_TIME      3  // 3 * 20ms = 60ms
+
+DccStateStore store;
+relayClass relay[numberOfRelays];
+uint8_t next;
+long tLast;
+
+
+void setup() {
+  Serial.begin(115200);
+  delay(100);
+  store.attach(E2END + 1 - 100, 100);
+  for (uint8_t i = 0; i < numberOfRelays; i++) {
+    relay[i].init(pinPos1[i], pinPos2[i], HOLD_TIME, &store, i);
+    Serial.print("Relay ");
+    Serial.print(i);
+    Serial.print(": ");
+    if (relay[i].state == relayClass::POS1) Serial.println("POS1");
+    else if (relay[i].state == relayClass::POS2) Serial.println("POS2");
+    else Serial.println("UNKNOWN");
+  }
+}
+
+
+void loop() {
+  if ((millis() - tLast) > 3000) {
+    tLast = millis();
+    if (relay[next].state == relayClass::POS1) relay[next].activate(relayClass::POS2);
+    else relay[next].activate(relayClass::POS1);     // If UNKNOWN or POS2
+    next = (next + 1) % numberOfRelays;
+  }
+  for (uint8_t i = 0; i < numberOfRelays; i++) relay[i].update();
+  store.update();
+}
@@ -0,0 +1,69 @@
+//******************************************************************************************************
+//
+// Jitter measurement of DccOneShot timers
+//
+// A DccOneShot timer is repeatedly started with a pseudo-random duration between 50us and 5ms.
+// The callback compares micros() with the intended deadline. After 1000 runs the sketch prints
+// the minimum, average and maximum deviation (in microseconds), for callbacks from the interrupt
+// service routine as well as for deferred callbacks.
+// Note that the deviation includes the resolution of micros() (4us on a 16MHz ATMega328).
+// The hardware timer is only used if DCC_CORE_ONESHOT is set to 1 in core_features.h; otherwise
+// this sketch measures the deviation of callbacks that are called from DccOneShot::update().
+//
+// 2026/10/18 AP
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DccOneShot.h>
+
+const uint16_t runs = 1000;
+
+DccOneShot oneShot;
+volatile unsigned long deadline;
+volatile long deviation;
+volatile bool done;
+
+
+void callback() {
+  deviation = (long)(micros() - deadline);
+  done = true;
+}
+
+
+void measure(bool deferred) {
+  long minimum = 0x7FFFFFFF;
+  long maximum = -0x7FFFFFFF;
+  long total = 0;
+  for (uint16_t i = 0; i < runs; i++) {
+    unsigned long duration = random(50, 5000);
+    done = false;
+    deadline = micros() + duration;
+    oneShot.start(duration, callback, deferred);
+    while (!done) DccOneShot::update();
+    if (deviation < minimum) minimum = deviation;
+    if (deviation > maximum) maximum = deviation;
+    total += deviation;
+  }
+  Serial.print(deferred ? "Deferred: " : "ISR:      ");
+  Serial.print("min = ");
+  Serial.print(minimum);
+  Serial.print("us, avg = ");
+  Serial.print(total / (long)runs);
+  Serial.print("us, max = ");
+  Serial.print(maximum);
+  Serial.println("us");
+}
+
+
+void setup() {
+  Serial.begin(115200);
+  delay(100);
+  Serial.println("DccOneShot jitter measurement");
+}
+
+
+void loop() {
+  measure(false);
+  measure(true);
+  delay(2000);
+}
@@ -0,0 +1,86 @@
+//******************************************************************************************************
+//
+// Benchmark: 64 DccTimer objects versus a DccTimerWheel with 64 timers
+//
+// Both schemes run 64 periodic timers, with periods between 100ms and 2 seconds. For each scheme
+// the sketch measures during 5 seconds the number of loops, and prints the average time (in
+// microseconds) that is needed per loop to service all timers. The number of expiries is
+// printed as well, to check that both schemes do the same amount of work.
+//
+// 2026/10/18 AP
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DccTimer.h>
+#include <AP_DccTimerWheel.h>
+
+const uint8_t numberOfTimers = 64;
+const unsigned long testTime = 5000;
+
+DccTimer timer[numberOfTimers];
+DccWheelSlot slots[numberOfTimers];
+DccTimerWheel wheel;
+unsigned long wheelExpiries;
+
+
+unsigned long period(uint8_t i) {
+  return 100 + (i * 30);
+}
+
+
+void wheelCallback(uint8_t handle) {
+  wheelExpiries++;
+  wheel.start(handle, period(handle));
+}
+
+
+void report(const char *name, unsigned long loops, unsigned long busy, unsigned long expiries) {
+  Serial.print(name);
+  Serial.print(": loops = ");
+  Serial.print(loops);
+  Serial.print(" - expiries = ");
+  Serial.print(expiries);
+  Serial.print(" - average time per loop (us) = ");
+  Serial.println((float)busy / loops);
+}
+
+
+void setup() {
+  Serial.begin(115200);
+  delay(100);
+  // Test 1: DccTimer objects
+  for (uint8_t i = 0; i < numberOfTimers; i++) timer[i].setTime(period(i));
+  unsigned long loops = 0;
+  unsigned long busy = 0;
+  unsigned long expiries = 0;
+  unsigned long tStart = millis();
+  while (millis() - tStart < testTime) {
+    unsigned long t0 = micros();
+    for (uint8_t i = 0; i < numberOfTimers; i++) {
+      if (timer[i].expired()) {
+        expiries++;
+        timer[i].start();
+      }
+    }
+    busy += micros() - t0;
+    loops++;
+  }
+  report("DccTimer     ", loops, busy, expiries);
+  // Test 2: DccTimerWheel
+  wheel.attach(slots, numberOfTimers);
+  for (uint8_t i = 0; i < numberOfTimers; i++) wheel.start(wheel.create(wheelCallback), period(i));
+  loops = 0;
+  busy = 0;
+  tStart = millis();
+  while (millis() - tStart < testTime) {
+    unsigned long t0 = micros();
+    wheel.update();
+    busy += micros() - t0;
+    loops++;
+  }
+  report("DccTimerWheel", loops, busy, wheelExpiries);
+}
+
+
+void loop() {
+}
@@ -0,0 +1,53 @@
+//******************************************************************************************************
+//
+// Test sketch for the DccTrace trace buffer
+// 2026/10/18 AP
+//
+// A switch decoder skeleton that stores trace events instead of printing text. Next to the events
+// of the core (programming commands, CV writes, PoM answers, reboots), each accessory command for
+// this decoder is stored as a user event. The events are sent without blocking by
+// traceBuffer.update(). Connect extras/dcctrace.py to the serial port to see the timeline:
+//
+//   python3 extras/dcctrace.py /dev/ttyUSB0 115200
+//
+// Tracing should be enabled in core_features.h (#define DCC_CORE_TRACE 1), or with the compiler
+// flag -DDCC_CORE_TRACE=1.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <AP_DCC_Decoder_Core.h>
+
+#if !DCC_CORE_TRACE
+  #error "Set DCC_CORE_TRACE to 1 in core_features.h"
+#endif
+
+#define traceAccessory  (traceUser + 0)       // a: turnout, b: position
+
+
+void setup() {
+  Serial.begin(115200);
+  traceBuffer.attach(Serial);
+  cvValues.init(SwitchDecoder, 20);
+  decoderHardware.init();
+}
+
+
+void loop() {
+  if (dcc.input()) {
+    switch (dcc.cmdType) {
+      case Dcc::MyAccessoryCmd :
+        dccTrace(traceAccessory, accCmd.turnout, accCmd.position);
+      break;
+      case Dcc::MyPomCmd :
+        cvProgramming.processMessage(Dcc::MyPomCmd);
+      break;
+      case Dcc::SmCmd :
+        cvProgramming.processMessage(Dcc::SmCmd);
+      break;
+      default:
+      break;
+    }
+  }
+  decoderHardware.update();
+  traceBuffer.update();
+}
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#******************************************************************************************************
+#
+# file:      cvtool.py
+# Author:    Aiko Pras
+# History:   2026/10/18 AP Version 1.0
+#            2026/10/18 AP Version 1.1 CV26, CV31 and CV32 (live error counters) are never written
+#
+# purpose:   Saves the CVs of a decoder into a profile, or writes a profile to a decoder, using the
+#            serial block protocol of DccCvSerial (see src/AP_DccCvSerial.h).
+#
+# A profile is a text file with one CV per line: the CV number and its value. Empty lines and text
+# after a '#' are ignored. The special CVs 7 (version), 8 (VID: 0x0D restores the defaults),
+# 23 (search) and 25 (restart) are never written, and neither are the CVs 26, 31 and 32, which read
+# back as live error counters. After writing, the CVs are read back and compared.
+#
+# Usage:     cvtool.py read  <port> <profile> [first [last]]     (default: CV 1..63)
+#            cvtool.py write <port> <profile>
+# Requires:  pyserial
+#
+#******************************************************************************************************
+import sys
+import time
+
+SYNC = 0x7E
+BLOCK_SIZE = 32
+SPECIAL_CVS = (7, 8, 23, 25, 26, 31, 32)
+ERRORS = {1: "CRC error", 2: "CV number out of range", 3: "incorrect length", 4: "unknown command"}
+
+
+def crc16(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class Decoder:
+    def __init__(self, port, baudrate=115200):
+        import serial                   # pyserial
+        self.uart = serial.Serial(port, baudrate, timeout=1)
+        time.sleep(2)                   # Opening the port may reset the board
+        self.uart.reset_input_buffer()
+
+    def request(self, cmd, first, length, data=b""):
+        body = bytes([ord(cmd), first & 0xFF, first >> 8, length]) + bytes(data)
+        crc = crc16(body)
+        self.uart.write(bytes([SYNC]) + body + bytes([crc & 0xFF, crc >> 8]))
+        return self.answer()
+
+    def answer(self):
+        while True:
+            c = self.uart.read(1)
+            if not c:
+                raise IOError("no answer from decoder")
+            if c[0] == SYNC:
+                break
+        header = self.uart.read(4)
+        if len(header) < 4:
+            raise IOError("incomplete answer")
+        rest = self.uart.read(header[3] + 2)
+        if len(rest) < header[3] + 2:
+            raise IOError("incomplete answer")
+        data, crc = rest[:-2], rest[-2] | (rest[-1] << 8)
+        if crc != crc16(header + data):
+            raise IOError("CRC error in answer")
+        if header[0] == ord('e'):
+            raise IOError("decoder reports: " + ERRORS.get(data[0], "error %d" % data[0]))
+        return chr(header[0]), data
+
+    def read(self, first, count):
+        values = bytearray()
+        while count > 0:
+            n = min(count, BLOCK_SIZE)
+            cmd, data = self.request('R', first, n)
+            values += data
+            first += n
+            count -= n
+        return values
+
+    def write(self, first, values):
+        for i in range(0, len(values), BLOCK_SIZE):
+            block = values[i:i + BLOCK_SIZE]
+            self.request('W', first + i, len(block), block)
+
+
+def load_profile(filename):
+    profile = {}
+    with open(filename) as f:
+        for line in f:
+            line = line.split('#')[0].split()
+            if len(line) >= 2:
+                profile[int(line[0], 0)] = int(line[1], 0) & 0xFF
+    return profile
+
+
+def blocks(profile):
+    # Groups consecutive CVs, so that each group can be written with a single request
+    numbers = sorted(cv for cv in profile if cv not in SPECIAL_CVS)
+    group = []
+    for cv in numbers:
+        if group and cv != group[-1] + 1:
+            yield group
+            group = []
+        group.append(cv)
+    if group:
+        yield group
+
+
+def cmd_read(port, filename, first=1, last=63):
+    values = Decoder(port).read(first, last - first + 1)
+    with open(filename, "w") as f:
+        f.write("# CV  value\n")
+        for i, value in enumerate(values):
+            f.write("%4d  %3d\n" % (first + i, value))
+    print("%d CVs saved in %s" % (len(values), filename))
+
+
+def cmd_write(port, filename):
+    profile = load_profile(filename)
+    decoder = Decoder(port)
+    errors = 0
+    written = 0
+    for group in blocks(profile):
+        decoder.write(group[0], bytes(profile[cv] for cv in group))
+        actual = decoder.read(group[0], len(group))
+        for cv, value in zip(group, actual):
+            if value != profile[cv]:
+                print("CV %d: expected %d, read %d" % (cv, profile[cv], value))
+                errors += 1
+        written += len(group)
+    print("%d CVs written, %d differences" % (written, errors))
+    return 1 if errors else 0
+
+
+def main():
+    if len(sys.argv) < 4 or sys.argv[1] not in ("read", "write"):
+        sys.stderr.write("usage: cvtool.py read <port> <profile> [first [last]]\n"
+                         "       cvtool.py write <port> <profile>\n")
+        return 2
+    if sys.argv[1] == "read":
+        first = int(sys.argv[4]) if len(sys.argv) > 4 else 1
+        last = int(sys.argv[5]) if len(sys.argv) > 5 else 63
+        cmd_read(sys.argv[2], sys.argv[3], first, last)
+        return 0
+    return cmd_write(sys.argv[2], sys.argv[3])
+
+
+if __name__ == "__main__":
+    sys.exit(main())
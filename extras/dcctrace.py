@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+#******************************************************************************************************
+#
+# file:      dcctrace.py
+# Author:    Aiko Pras
+# History:   2026/10/18 AP Version 1.0
+#
+# purpose:   Converts the binary frames of DccTrace (see src/AP_DccTrace.h) into a readable timeline.
+#
+# Each frame has 7 bytes: 0xA5, id, time (low, high), a, b, checksum (XOR of the 5 bytes before).
+# Bytes that do not belong to a valid frame (for example text from Serial.print()) are skipped.
+# The 16 bit timestamps are extended to 32 bit, assuming that consecutive events are less than
+# 65 seconds apart.
+#
+# Usage:     dcctrace.py dump.bin                 (a file with captured serial data)
+#            dcctrace.py /dev/ttyUSB0 [baudrate]  (reads directly from the serial port, requires pyserial)
+#
+#******************************************************************************************************
+import sys
+
+SYNC = 0xA5
+FRAME_SIZE = 7
+
+OPERATIONS = {1: "verifyByte", 2: "bitManipulation", 3: "writeByte"}    # CvAccess::CvOperation_t
+
+
+def describe(event_id, a, b):
+    if event_id == 0x01:
+        return "LOST       %d events" % a
+    if event_id == 0x02:
+        return "PROG CMD   %s %s" % ("PoM" if a else "SM", OPERATIONS.get(b, "operation %d" % b))
+    if event_id == 0x03:
+        return "CV WRITE   CV (low byte) %d = %d" % (a, b)
+    if event_id == 0x04:
+        return "POM ANSWER %d" % a
+    if event_id == 0x05:
+        return "ADDRESS    CV1 = %d, CV9 = %d" % (a, b)
+    if event_id == 0x06:
+        return "RELAY      pin %d -> %s" % (a, "POS1" if b == 0 else "POS2")
+    if event_id == 0x07:
+        return "REBOOT"
+    if event_id >= 0x80:
+        return "USER %-5d a = %d, b = %d" % (event_id - 0x80, a, b)
+    return "UNKNOWN %d a = %d, b = %d" % (event_id, a, b)
+
+
+def frames(data):
+    i = 0
+    while i + FRAME_SIZE <= len(data):
+        f = data[i:i + FRAME_SIZE]
+        if f[0] == SYNC and (f[1] ^ f[2] ^ f[3] ^ f[4] ^ f[5]) == f[6]:
+            yield f[1], f[2] | (f[3] << 8), f[4], f[5]
+            i += FRAME_SIZE
+        else:
+            i += 1
+
+
+def timeline(data, out=sys.stdout):
+    previous = None
+    wraps = 0
+    for event_id, time, a, b in frames(data):
+        if previous is not None and time < previous:
+            wraps += 1
+        previous = time
+        out.write("%10.3f s  %s\n" % ((wraps * 65536 + time) / 1000.0, describe(event_id, a, b)))
+
+
+def read_serial(port, baudrate):
+    import serial                       # pyserial
+    buffer = bytearray()
+    with serial.Serial(port, baudrate, timeout=0.5) as uart:
+        try:
+            while True:
+                buffer += uart.read(256)
+        except KeyboardInterrupt:
+            pass
+    return bytes(buffer)
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.stderr.write("usage: dcctrace.py <dump file | serial port> [baudrate]\n")
+        return 1
+    source = sys.argv[1]
+    if source.startswith("/dev/") or source.upper().startswith("COM"):
+        baudrate = int(sys.argv[2]) if len(sys.argv) > 2 else 115200
+        data = read_serial(source, baudrate)
+    else:
+        with open(source, "rb") as f:
+            data = f.read()
+    timeline(data)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,53 @@
+#!/bin/sh
+#******************************************************************************************************
+#
+# file:      footprint.sh
+# Author:    Aiko Pras
+# History:   2026/10/18 AP Version 1.0
+#
+# purpose:   Reports the flash and RAM usage of the decoder core, per board and per feature set.
+#
+# A sketch (default: examples/BasicDecoder) is compiled with arduino-cli for each board (FQBN)
+# and each feature set. Since BasicDecoder also uses Serial, the differences between the
+# feature sets are more meaningful than the absolute numbers. A feature set is a list of compiler
+# flags that exclude subsystems, as described in src/core_features.h. The output is a
+# markdown table, that can be included in the documentation.
+#
+# Usage:     extras/footprint.sh [sketch-dir]
+# Requires:  arduino-cli, with the cores for the boards below installed, and the AP_DCC_library
+#            and RSbus libraries available.
+# The boards can be changed via the FQBNS environment variable (space separated).
+#
+#******************************************************************************************************
+cd "$(dirname "$0")/.." || exit 1
+LIBDIR=$(pwd)
+SKETCH=${1:-examples/BasicDecoder}
+FQBNS=${FQBNS:-"arduino:avr:uno MightyCore:avr:16 MegaCoreX:megaavr:4809 DxCore:megaavr:avrda"}
+
+# Name and compiler flags of each feature set
+FEATURES="
+full|
+no-led|-DDCC_CORE_LED=0
+no-button|-DDCC_CORE_PROG_BUTTON=0
+no-pom-feedback|-DDCC_CORE_POM_FEEDBACK=0
+no-cv-programming|-DDCC_CORE_CV_PROGRAMMING=0
+no-dispatch|-DDCC_CORE_DISPATCH=0
+no-feedback|-DDCC_CORE_FEEDBACK=0
+no-quality|-DDCC_CORE_QUALITY=0
+minimal|-DDCC_CORE_LED=0 -DDCC_CORE_PROG_BUTTON=0 -DDCC_CORE_CV_PROGRAMMING=0 -DDCC_CORE_DISPATCH=0 -DDCC_CORE_FEEDBACK=0 -DDCC_CORE_QUALITY=0
+"
+
+echo "| Board | Features | Flash (bytes) | RAM (bytes) |"
+echo "|-------|----------|--------------:|------------:|"
+for fqbn in $FQBNS; do
+  echo "$FEATURES" | while IFS='|' read -r name flags; do
+    [ -z "$name" ] && continue
+    out=$(arduino-cli compile --fqbn "$fqbn" --library "$LIBDIR" \
+          --build-property "compiler.cpp.extra_flags=$flags" "$SKETCH" 2>&1)
+    flash=$(echo "$out" | sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p')
+    ram=$(echo "$out" | sed -n 's/^Global variables use \([0-9]*\) bytes.*/\1/p')
+    [ -z "$flash" ] && flash="error"
+    [ -z "$ram" ] && ram="error"
+    echo "| $fqbn | $name | $flash | $ram |"
+  done
+done
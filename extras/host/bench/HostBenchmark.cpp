@@ -0,0 +1,72 @@
+//******************************************************************************************************
+//
+// file:      HostBenchmark.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Measures on the host the time per call of the functions a decoder calls from loop().
+//
+// The numbers are not those of an AVR. They are meant to compare two versions of the core on the
+// same PC, for example before and after a change. For cycle counts on the target itself, see
+// examples/Benchmark/Core-Cycles. The simulated clock advances 4us per iteration, so that the
+// 20ms and 100ms paths of the update() functions are taken in the usual proportion.
+//
+//******************************************************************************************************
+#include <chrono>
+#include <stdio.h>
+#include "AP_DCC_Decoder_Core.h"
+#include "AP_DccRelay.h"
+#include "HostShim.h"
+
+#define benchIterations   2000000UL
+
+static volatile uint8_t sink;         // Keeps the compiler from removing the calls
+
+
+template <typename F> static void bench(const char *name, F function) {
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < benchIterations; i++) {
+    function();
+    hostAdvanceMicros(4);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(stop - start).count() / benchIterations;
+  printf("%-36s %8.1f ns/call\n", name, ns);
+}
+
+
+int main(void) {
+  hostReset();
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  decoderHardware.init();
+
+  bench("decoderHardware.update()", [] {decoderHardware.update();});
+
+  cvCmd.operation = CvAccess::verifyByte;
+  cvCmd.number = T_on_F1;
+  cvCmd.value = 0;
+  bench("cvProgramming.processMessage(SM)", [] {cvProgramming.processMessage(Dcc::SmCmd);});
+
+  static relayClass relay;
+  relay.init(8, 9, 3);
+  bench("relay.activate() + update()", [] {
+    static unsigned long n;
+    if ((++n & 0x3FFF) == 0) relay.activate((relay.state == relayClass::POS1) ? relayClass::POS2 : relayClass::POS1);
+    relay.update();
+  });
+
+  static DccLed led;
+  led.attach(4);
+  led.flashFast();
+  bench("DccLed.update()", [] {led.update();});
+
+  static DccButton button;
+  button.attach(6);
+  bench("DccButton.read()", [] {sink = button.read();});
+
+  static DccTimer timer;
+  timer.setTime(1000);
+  bench("DccTimer.expired()", [] {if (timer.expired()) timer.start();});
+  return 0;
+}
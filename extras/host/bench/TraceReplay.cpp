@@ -0,0 +1,300 @@
+//******************************************************************************************************
+//
+// file:      TraceReplay.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version (examples/Benchmark/Trace-Replay)
+//            2026-10-18 V1.1 ap: Bit manipulation lines, EEPROM writes via cvValues.eepromWrites
+//            2026-10-18 V1.2 ap: Host program; commands are DCC packets, received via dcc.input()
+//
+// purpose:   Replays traces of DCC packets through the decoder core, and measures throughput,
+//            latency and the number of EEPROM writes.
+//
+//   trace_replay [runs] file ...     Replays each trace file `runs` times (default: 1)
+//
+// Each trace line (see TraceReplay.md) becomes a DCC packet, including the error detection byte.
+// The packet is decoded by the DCC stand-in of the shim (hostDccPacket()), after which the loop
+// below does what the loop of a decoder sketch does: dcc.input(), a switch on dcc.cmdType, and
+// the calls of the update() functions. Accessory commands for the decoder switch four relays via
+// a coil scheduler; PoM and SM commands go to cvProgramming.processMessage().
+//
+// Per trace the program prints:
+// - the number of packets, of commands for this decoder and of commands per second
+// - the latency from handing the packet to the DCC input till the loop has handled the command
+// - the latency from a PoM verify packet till its answer is queued for RS-Bus address 128. The
+//   answer is sent on the RS-Bus at the next poll of that address, which is not included.
+// - the number of EEPROM writes: all EEPROM bytes that changed (cvValues.eepromWrites), including
+//   those of special CVs, such as a reset to the default values via CV8
+// Times are those of the PC, and meant to compare versions of the core. The simulated clock
+// advances packetTime per packet, the time a DCC packet takes on the rails.
+//
+// The program returns 1 if a PoM verify packet for this decoder did not result in an answer.
+//
+//******************************************************************************************************
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "AP_DCC_Decoder_Core.h"
+#include "AP_DccRelay.h"
+#include "AP_DccCoilScheduler.h"
+#include "HostShim.h"
+
+#define replayDecoderAddress  1       // Decoder address of the decoder (CV1 = 2)
+#define packetTime            5       // ms per DCC packet
+#define maxPacketSize         8
+#define maxLineSize           80
+
+typedef std::chrono::steady_clock hostClock;
+
+const uint8_t numberOfRelays = 4;
+relayClass relay[numberOfRelays];
+DccCoilScheduler coils;
+
+struct statistics_t {
+  unsigned long packets;
+  unsigned long commands;                     // Commands for this decoder
+  unsigned long eepromWrites;
+  double totalLatency;                        // us
+  double maxLatency;                          // us
+  unsigned long pomAnswers;
+  unsigned long pomMissing;                   // PoM verify packets without answer
+  double totalPomLatency;                     // us
+  double maxPomLatency;                       // us
+  double elapsed;                             // us
+} stats;
+
+
+//******************************************************************************************************
+// The loop of a decoder sketch
+//******************************************************************************************************
+void handleAccessory() {
+  uint8_t index = (accCmd.turnout - 1) % numberOfRelays;
+  if (accCmd.activate) {
+    if (accCmd.position) relay[index].activate(relayClass::POS2);
+    else relay[index].activate(relayClass::POS1);
+  }
+}
+
+
+bool decoderLoop() {
+  bool command = false;
+  if (dcc.input()) {
+    switch (dcc.cmdType) {
+      case Dcc::MyAccessoryCmd :
+        handleAccessory();
+        command = true;
+      break;
+      case Dcc::MyPomCmd :
+        cvProgramming.processMessage(Dcc::MyPomCmd);
+        command = true;
+      break;
+      case Dcc::SmCmd :
+        cvProgramming.processMessage(Dcc::SmCmd);
+        command = true;
+      break;
+      default:
+      break;
+    }
+  }
+  for (uint8_t i = 0; i < numberOfRelays; i++) relay[i].update();
+  coils.update();
+  decoderHardware.update();
+  return command;
+}
+
+
+//******************************************************************************************************
+// DCC packets (RCN-213, RCN-214, RCN-216)
+//******************************************************************************************************
+uint8_t addErrorByte(uint8_t *packet, uint8_t size) {
+  uint8_t check = 0;
+  for (uint8_t i = 0; i < size; i++) check ^= packet[i];
+  packet[size] = check;
+  return size + 1;
+}
+
+
+uint8_t accessoryPacket(uint8_t *packet, unsigned int decoderAddress, uint8_t turnout,
+                        uint8_t position, uint8_t activate) {
+  unsigned int address = decoderAddress + 1;  // Address in the packet; 0 is not used
+  packet[0] = 0x80 | (address & 0x3F);
+  packet[1] = 0x80 | ((~address >> 2) & 0x70) | ((activate & 1) << 3) | (((turnout - 1) & 3) << 1)
+              | (position & 1);
+  return addErrorByte(packet, 2);
+}
+
+
+uint8_t operation(char c) {
+  if (c == 'W') return CvAccess::writeByte;
+  if (c == 'B') return CvAccess::bitManipulation;
+  return CvAccess::verifyByte;
+}
+
+
+// PoM (operations mode, for the PoM loco address of the decoder) or SM (programming track)
+uint8_t cvPacket(uint8_t *packet, bool pom, unsigned int cv, uint8_t op, uint8_t value) {
+  uint8_t size = 0;
+  if (pom) {
+    packet[size++] = 0xC0 | ((hostLocoAddress >> 8) & 0x3F);
+    packet[size++] = hostLocoAddress & 0xFF;
+  }
+  packet[size++] = (pom ? 0xE0 : 0x70) | (op << 2) | (((cv - 1) >> 8) & 0x03);
+  packet[size++] = (cv - 1) & 0xFF;
+  packet[size++] = value;
+  return addErrorByte(packet, size);
+}
+
+
+//******************************************************************************************************
+// Trace execution
+//******************************************************************************************************
+void replayPacket(const uint8_t *packet, uint8_t size, bool serviceMode) {
+  uint16_t writes = cvValues.eepromWrites;
+  uint16_t answers = hostRsbusCount;
+  hostClock::time_point start = hostClock::now();
+  hostDccPacket(packet, size, serviceMode);
+  bool command = decoderLoop();
+  double latency = std::chrono::duration<double, std::micro>(hostClock::now() - start).count();
+  stats.packets++;
+  stats.eepromWrites += (uint16_t)(cvValues.eepromWrites - writes);
+  if (command) {
+    stats.commands++;
+    stats.totalLatency += latency;
+    if (latency > stats.maxLatency) stats.maxLatency = latency;
+  }
+  if (command && (dcc.cmdType == Dcc::MyPomCmd) && (cvCmd.operation == CvAccess::verifyByte)) {
+    if (hostRsbusCount == answers) stats.pomMissing++;
+    else {
+      stats.pomAnswers++;
+      stats.totalPomLatency += latency;
+      if (latency > stats.maxPomLatency) stats.maxPomLatency = latency;
+    }
+  }
+  hostRsbusCount = 0;                         // The shim keeps a limited number of bytes
+  hostAdvance(packetTime);
+}
+
+
+// Returns false for comments and empty lines
+bool parseLine(const char *line, uint8_t *packet, uint8_t &size, bool &serviceMode) {
+  char *p = (char *)line + 1;
+  serviceMode = false;
+  switch (line[0]) {
+    case 'A': {
+      unsigned int decoderAddress = strtoul(p, &p, 10);
+      uint8_t turnout = strtoul(p, &p, 10);
+      uint8_t position = strtoul(p, &p, 10);
+      uint8_t activate = strtoul(p, &p, 10);
+      size = accessoryPacket(packet, decoderAddress, turnout, position, activate);
+      return true;
+    }
+    case 'P':
+    case 'S': {
+      unsigned int cv = strtoul(p, &p, 10);
+      while (*p == ' ') p++;
+      uint8_t op = operation(*p++);
+      uint8_t value = strtoul(p, &p, 10);
+      serviceMode = (line[0] == 'S');
+      size = cvPacket(packet, !serviceMode, cv, op, value);
+      return true;
+    }
+    case 'D':
+    case 'M':
+      // Raw packet, including the error detection byte
+      serviceMode = (line[0] == 'M');
+      size = 0;
+      while (*p && (size < maxPacketSize)) {
+        char *end;
+        unsigned long byte = strtoul(p, &end, 16);
+        if (end == p) break;
+        packet[size++] = byte;
+        p = end;
+      }
+      return (size > 0);
+    default:
+      return false;
+  }
+}
+
+
+bool replayFile(const char *name) {
+  FILE *file = fopen(name, "r");
+  if (file == nullptr) {
+    perror(name);
+    return false;
+  }
+  uint8_t packet[maxPacketSize];
+  uint8_t size = 0;
+  bool serviceMode = false;
+  bool valid = false;                         // A previous packet exists, for repeats
+  char line[maxLineSize];
+  hostClock::time_point start = hostClock::now();
+  while (fgets(line, sizeof(line), file)) {
+    if (line[0] == 'R') {
+      unsigned long repeats = strtoul(line + 1, nullptr, 10);
+      for (unsigned long i = 0; valid && (i < repeats); i++) {
+        replayPacket(packet, size, serviceMode);
+      }
+    }
+    else if (parseLine(line, packet, size, serviceMode)) {
+      valid = true;
+      replayPacket(packet, size, serviceMode);
+    }
+  }
+  stats.elapsed += std::chrono::duration<double, std::micro>(hostClock::now() - start).count();
+  fclose(file);
+  return true;
+}
+
+
+void printStatistics(const char *name) {
+  printf("%s: packets = %lu, commands = %lu, per second = %.0f\n", name, stats.packets,
+         stats.commands, stats.elapsed ? (stats.commands * 1000000.0) / stats.elapsed : 0);
+  printf("  latency avg = %.2fus, max = %.2fus\n",
+         stats.commands ? stats.totalLatency / stats.commands : 0, stats.maxLatency);
+  printf("  PoM answers = %lu, latency avg = %.2fus, max = %.2fus", stats.pomAnswers,
+         stats.pomAnswers ? stats.totalPomLatency / stats.pomAnswers : 0, stats.maxPomLatency);
+  if (stats.pomMissing) printf(", MISSING = %lu", stats.pomMissing);
+  printf("\n  EEPROM writes = %lu\n", stats.eepromWrites);
+}
+
+
+//******************************************************************************************************
+void startDecoder() {
+  hostReset();
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  cvValues.write(myAddrL, (replayDecoderAddress + 1) & 0x3F);
+  cvValues.write(myAddrH, (replayDecoderAddress + 1) >> 6);
+  decoderHardware.init();
+  coils.attach(1, 0);
+  for (uint8_t i = 0; i < numberOfRelays; i++) {
+    relay[i].init(4 + (2 * i), 5 + (2 * i), 3);
+    relay[i].useScheduler(&coils);
+  }
+}
+
+
+int main(int argc, char *argv[]) {
+  int first = 1;
+  unsigned long runs = 1;
+  if ((argc > 1) && (argv[1][0] >= '0') && (argv[1][0] <= '9')) {
+    runs = strtoul(argv[1], nullptr, 10);
+    first = 2;
+  }
+  if (first >= argc) {
+    fprintf(stderr, "usage: trace_replay [runs] file ...\n");
+    return 2;
+  }
+  bool missing = false;
+  for (int i = first; i < argc; i++) {
+    startDecoder();
+    memset(&stats, 0, sizeof(stats));
+    for (unsigned long run = 0; run < runs; run++) {
+      if (!replayFile(argv[i])) return 2;
+    }
+    printStatistics(argv[i]);
+    missing |= (stats.pomMissing > 0);
+  }
+  return missing ? 1 : 0;
+}
@@ -0,0 +1,242 @@
+//******************************************************************************************************
+//
+// file:      CvFuzz.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Fuzz harness for CV programming (SM and PoM) and address programming via the
+//            programming button. Works with libFuzzer, AFL and the standalone driver FuzzMain.cpp.
+//
+// An input is a sequence of 6 byte records. Each record is one step of the decoder:
+//   byte 0:     step: 0 = SM command, 1 = PoM command, 2 = address programming, 3 = power cycle
+//   byte 1..2:  CV number (little endian, 0..65535), or the decoder address (step 2)
+//   byte 3:     CV operation (0..3, as CvAccess::CvOperation_t), or the command type (step 2)
+//   byte 4:     CV value, or the low byte of the output address (step 2)
+//   byte 5:     bit manipulation: 111KDBBB, or the high byte of the output address (step 2)
+// Each input starts with the EEPROM of a switch decoder with default values. A reboot restarts
+// the decoder (longjmp from hostRebootHook), and the next record is executed.
+//
+// After each step the following invariants are checked. A violation aborts the program, so that
+// the fuzzer stores the input:
+// - No EEPROM access outside the EEPROM.
+// - A CV command changes at most the addressed CV, and only if that CV is writeable: not CV0,
+//   CV7 (version), CV8 (VID), CV23 (Search), CV25 (Restart) or a diagnostic CV. The stored value
+//   is the value of the command (write byte), or the result of the bit write.
+// - Reboots only occur after writing 0x0D to CV8 (which must restore the defaults), writing a
+//   value above 0 to CV25, or address programming with a valid address.
+// - Address programming stores a valid address: decoder address 0..510, output address 1..2047,
+//   RS-Bus address 0..128. An invalid address, or a command that is not an accessory command,
+//   changes nothing.
+// - A power cycle changes nothing in EEPROM.
+//
+//******************************************************************************************************
+#include <setjmp.h>
+#include <stdio.h>
+#include "AP_DCC_Decoder_Core.h"
+#include "HostShim.h"
+
+#define recordSize        6
+
+typedef enum {smCommand, pomCommand, addressProgramming, powerCycle} step_t;
+
+static uint8_t freshEeprom[hostEepromSize];   // Switch decoder with default values
+static uint8_t before[hostEepromSize];        // EEPROM before the current step
+static bool prepared;
+static jmp_buf restartPoint;
+
+// The current step, needed after a reboot. Static, since locals may be lost by longjmp()
+static const uint8_t *record;
+static size_t position;
+static bool rebootAllowed;
+
+
+static void violation(const char *invariant) {
+  fprintf(stderr, "CvFuzz: %s (step %u, record %02X %02X %02X %02X %02X %02X)\n", invariant,
+          (unsigned)(position / recordSize), record[0], record[1], record[2], record[3], record[4],
+          record[5]);
+  abort();
+}
+
+
+static void restart(void) {longjmp(restartPoint, 1);}
+
+
+static void startDecoder(void) {
+  hostAutoTick = false;
+  hostSetInput(buttonPin, HIGH);
+  hostScheduleInput(buttonPin, HIGH, 0);      // Cancels a pending button press
+  decoderHardware.init();
+  hostAdvance(100);
+  decoderHardware.update();                   // The gesture recogniser sees the button released
+}
+
+
+//******************************************************************************************************
+// CV commands
+//******************************************************************************************************
+static bool writeableCv(unsigned int number) {
+  if ((number == 0) || (number >= hostEepromSize)) return false;
+  if ((number == version) || (number == VID) || (number == Search) || (number == Restart)) return false;
+  #if DCC_CORE_QUALITY
+  if (signalQuality.isDiagnosticCv(number)) return false;
+  #endif
+  return true;
+}
+
+
+static void cvStep(step_t step) {
+  unsigned int number = record[1] | (record[2] << 8);
+  cvCmd.number = number;
+  cvCmd.operation = (CvAccess::CvOperation_t)(record[3] & 0x03);
+  cvCmd.value = record[4];
+  cvCmd.writecmd = bitRead(record[5], 4);
+  cvCmd.bitvalue = bitRead(record[5], 3);
+  cvCmd.bitposition = record[5] & 0x07;
+  // The value a write would store
+  bool write = false;
+  uint8_t value = 0;
+  if (number < hostEepromSize) {
+    if (cvCmd.operation == CvAccess::writeByte) {
+      write = true;
+      value = cvCmd.value;
+    }
+    if ((cvCmd.operation == CvAccess::bitManipulation) && cvCmd.writecmd) {
+      write = true;
+      value = cvCmd.writeBit(before[number]);
+    }
+  }
+  if (number == 0) write = false;
+  rebootAllowed = write && (((number == VID) && (value == 0x0D)) || ((number == Restart) && value));
+  cvProgramming.processMessage((step == smCommand) ? Dcc::SmCmd : Dcc::MyPomCmd);
+  if (hostEepromOutOfRange) violation("EEPROM access out of range");
+  for (uint16_t i = 0; i < hostEepromSize; i++) {
+    if (hostEeprom[i] == before[i]) continue;
+    if ((i != number) || !write || !writeableCv(number)) violation("CV changed that should not");
+    if (hostEeprom[i] != value) violation("Wrong value stored");
+  }
+}
+
+
+//******************************************************************************************************
+// Address programming: click the programming button, send an accessory command
+//******************************************************************************************************
+static void addressStep(void) {
+  accCmd.decoderAddress = (record[1] | (record[2] << 8)) & 0x03FF;     // 0..1023
+  accCmd.outputAddress = (record[4] | (record[5] << 8)) & 0x0FFF;      // 0..4095
+  uint8_t type = record[3] & 0x03;
+  bool accessory = (type <= 1);
+  // Which addresses are valid follows from CV27 (decoder type) and CV29 (configuration)
+  uint8_t cv29 = before[Config];
+  bool gbm = cvValues.isGBM();
+  bool outputAddr = bitRead(cv29, 6);
+  bool valid = outputAddr ? ((accCmd.outputAddress > 0) && (accCmd.outputAddress <= 2047))
+                          : (accCmd.decoderAddress <= 510);
+  rebootAllowed = accessory && bitRead(cv29, 7) && (valid || gbm);
+  if (type == 0) hostDccCommand(Dcc::AnyAccessoryCmd);
+  if (type == 1) hostDccCommand(Dcc::MyAccessoryCmd);
+  if (type == 2) hostDccCommand(Dcc::SmCmd);
+  // A click on the button. Address programming is then waiting for a DCC command, till the
+  // button is pressed again (after some 3 seconds).
+  hostAutoTick = true;
+  hostSetInput(buttonPin, LOW);
+  unsigned long end = millis() + 100;
+  while (millis() < end) decoderHardware.update();
+  hostSetInput(buttonPin, HIGH);
+  hostScheduleInput(buttonPin, LOW, millis() + 3000);
+  end = millis() + 3500;
+  while (millis() < end) decoderHardware.update();
+  // Still here: no reboot
+  hostSetInput(buttonPin, HIGH);
+  end = millis() + 100;
+  while (millis() < end) decoderHardware.update();
+  hostAutoTick = false;
+  if (hostEepromOutOfRange) violation("EEPROM access out of range");
+  if (rebootAllowed) violation("Address programming without reboot");
+  if (memcmp(hostEeprom, before, hostEepromSize)) violation("EEPROM changed without reboot");
+}
+
+
+static void checkAddress(void) {
+  uint8_t cv1 = hostEeprom[myAddrL];
+  uint8_t cv9 = hostEeprom[myAddrH];
+  uint8_t rsAddress = hostEeprom[myRSAddr];
+  if (rsAddress > 128) violation("RS-Bus address out of range");
+  if (cvValues.isGBM()) {
+    if ((cv1 != before[myAddrL]) || (cv9 != before[myAddrH])) violation("GBM changed CV1 / CV9");
+    return;
+  }
+  if (cv9 > 7) violation("CV9 out of range");
+  unsigned int address = cvValues.storedAddress();
+  if (bitRead(hostEeprom[Config], 6)) {
+    if ((address < 1) || (address > 2047)) violation("Output address out of range");
+    if (address != accCmd.outputAddress) violation("Wrong output address stored");
+  }
+  else {
+    if (cv1 > 63) violation("CV1 out of range");
+    if (address > 510) violation("Decoder address out of range");
+    if (address != accCmd.decoderAddress) violation("Wrong decoder address stored");
+  }
+}
+
+
+//******************************************************************************************************
+// After a reboot
+//******************************************************************************************************
+static void afterReboot(void) {
+  if (!rebootAllowed) violation("Unexpected reboot");
+  if (hostEepromOutOfRange) violation("EEPROM access out of range");
+  if ((record[0] & 0x03) == addressProgramming) {
+    checkAddress();
+    return;
+  }
+  unsigned int number = record[1] | (record[2] << 8);
+  if (number == VID) {
+    if (memcmp(hostEeprom, freshEeprom, max_cvs + 1)) violation("CV8 reset did not restore the defaults");
+  }
+  else if (memcmp(hostEeprom, before, hostEepromSize)) violation("CV25 restart changed EEPROM");
+}
+
+
+//******************************************************************************************************
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  if (!prepared) {
+    hostReset();
+    cvValues.init(SwitchDecoder);
+    cvValues.setDefaults();
+    memcpy(freshEeprom, hostEeprom, hostEepromSize);
+    prepared = true;
+  }
+  hostReset();
+  memcpy(hostEeprom, freshEeprom, hostEepromSize);
+  hostRebootHook = restart;
+  position = 0;
+  if (setjmp(restartPoint)) {
+    afterReboot();
+    position += recordSize;
+  }
+  startDecoder();
+  while (position + recordSize <= size) {
+    record = data + position;
+    memcpy(before, hostEeprom, hostEepromSize);
+    rebootAllowed = false;
+    switch (record[0] & 0x03) {
+      case smCommand:
+        cvStep(smCommand);
+      break;
+      case pomCommand:
+        cvStep(pomCommand);
+      break;
+      case addressProgramming:
+        addressStep();
+      break;
+      case powerCycle:
+        startDecoder();
+        if (hostEepromOutOfRange) violation("EEPROM access out of range");
+        if (memcmp(hostEeprom, before, hostEepromSize)) violation("Power cycle changed EEPROM");
+      break;
+    }
+    position += recordSize;
+  }
+  hostRebootHook = nullptr;
+  return 0;
+}
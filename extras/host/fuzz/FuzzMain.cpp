@@ -0,0 +1,87 @@
+//******************************************************************************************************
+//
+// file:      FuzzMain.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Standalone driver for the fuzz harness CvFuzz.cpp, for builds without libFuzzer.
+//
+//   cv_fuzz [runs [seed]]     Executes `runs` (default 10000) random inputs, and reports the
+//                             number of executions per second
+//   cv_fuzz file ...          Executes each file once (corpus replay, or AFL with @@)
+//
+// The random inputs are built from records (see CvFuzz.cpp) that favour the interesting cases:
+// CV numbers around the special CVs and the end of the EEPROM, and CV29 / CV27 values that
+// change the addressing mode and the decoder type.
+//
+//******************************************************************************************************
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define maxRecords        16
+#define recordSize        6
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+
+static unsigned int randomCv(void) {
+  switch (rand() % 4) {
+    case 0: return rand() % 40;                         // Common and special CVs
+    case 1: return 1020 + (rand() % 8);                 // End of the EEPROM
+    case 2: return 236 + (rand() % 20);                 // Diagnostic CVs
+    default: return rand() & 0xFFFF;
+  }
+}
+
+
+static size_t randomInput(uint8_t *data) {
+  uint8_t records = 1 + (rand() % maxRecords);
+  for (uint8_t i = 0; i < records; i++) {
+    uint8_t *record = data + (i * recordSize);
+    for (uint8_t j = 0; j < recordSize; j++) record[j] = rand();
+    unsigned int cv = randomCv();
+    record[1] = cv & 0xFF;
+    record[2] = cv >> 8;
+    if ((cv == 29) && (rand() & 1)) record[4] = 0x80 | (rand() & 0x40);   // Accessory decoder
+    if ((cv == 8) && (rand() & 1)) record[4] = 0x0D;
+    record[5] |= 0xE0;                                  // 111KDBBB
+  }
+  return records * recordSize;
+}
+
+
+static int replayFile(const char *name) {
+  static uint8_t data[4096];
+  FILE *file = fopen(name, "rb");
+  if (file == nullptr) {
+    perror(name);
+    return 1;
+  }
+  size_t size = fread(data, 1, sizeof(data), file);
+  fclose(file);
+  LLVMFuzzerTestOneInput(data, size);
+  return 0;
+}
+
+
+int main(int argc, char *argv[]) {
+  if ((argc > 1) && ((argv[1][0] < '0') || (argv[1][0] > '9'))) {
+    int result = 0;
+    for (int i = 1; i < argc; i++) result |= replayFile(argv[i]);
+    return result;
+  }
+  unsigned long runs = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000;
+  srand((argc > 2) ? strtoul(argv[2], nullptr, 10) : 1);
+  uint8_t data[maxRecords * recordSize];
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned long i = 0; i < runs; i++) {
+    size_t size = randomInput(data);
+    LLVMFuzzerTestOneInput(data, size);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  printf("cv_fuzz: %lu inputs, %.0f exec/s\n", runs, seconds > 0 ? runs / seconds : 0);
+  return 0;
+}
@@ -0,0 +1,94 @@
+//******************************************************************************************************
+//
+// file:      AP_DCC_library.h (host shim)
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//            2026-10-18 V1.1 ap: Commands may also be decoded from DCC packets (hostDccPacket)
+//
+// purpose:   Stand-ins for the objects of the AP_DCC_library, for the host build.
+//
+// The types and members are those used by the decoder core. There is no DCC signal: a test fills
+// in accCmd / cvCmd and queues the command type with hostDccCommand(), or hands a complete DCC
+// packet to hostDccPacket(), which decodes it; the next dcc.input() then returns true. DCC-Acks, and the addresses set by the core, are recorded for the tests.
+//
+//******************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+
+class Dcc {
+  public:
+    typedef enum {
+      NoCmd,
+      IgnoreCmd,
+      ResetCmd,
+      SomeLocoSpeedFlag,
+      SomeLocoMovesFlag,
+      MyLocoSpeedCmd,
+      MyEmergencyStopCmd,
+      MyLocoF0F4Cmd,
+      MyLocoF5F8Cmd,
+      MyLocoF9F12Cmd,
+      MyLocoF13F20Cmd,
+      MyLocoF21F28Cmd,
+      MyLocoF29F36Cmd,
+      MyLocoF37F44Cmd,
+      MyLocoF45F52Cmd,
+      MyLocoF53F60Cmd,
+      MyLocoF61F68Cmd,
+      MyLocoLoadCmd,
+      AnyAccessoryCmd,
+      MyAccessoryCmd,
+      MyPomCmd,
+      AnyPomCmd,
+      SmCmd
+    } CmdType_t;
+
+    CmdType_t cmdType;                // What kind of command is received
+    uint8_t errorXOR;                 // Number of messages with an XOR error
+
+    void attach(uint8_t dccPin, uint8_t ackPin);
+    void detach(void);
+    bool input(void);                 // True once for each command queued by hostDccCommand()
+    void sendAck(void);               // Counted in hostDccAcks
+};
+
+
+class Accessory {
+  public:
+    typedef enum { basic, extended } accCmdType_t;
+    accCmdType_t command;
+    unsigned int decoderAddress;      // 0..511
+    uint8_t turnout;                  // 1..4
+    unsigned int outputAddress;       // 1..2048
+    uint8_t position;                 // 0 (-) or 1 (+)
+    bool activate;
+    uint8_t myMaster;
+    void setMyAddress(unsigned int address);
+};
+
+
+class Loco {
+  public:
+    void setMyAddress(unsigned int address);
+};
+
+
+class CvAccess {
+  public:
+    typedef enum { reserved, verifyByte, bitManipulation, writeByte } CvOperation_t;
+    CvOperation_t operation;
+    unsigned int number;              // CV number, 1..1024
+    uint8_t value;                    // Byte value (verifyByte, writeByte)
+    bool writecmd;                    // bitManipulation: write (true) or verify (false)
+    uint8_t bitvalue;                 // bitManipulation: the value of the bit
+    uint8_t bitposition;              // bitManipulation: 0..7
+    uint8_t writeBit(uint8_t cvValue);    // cvValue, with bitposition set to bitvalue
+    bool verifyBit(uint8_t cvValue);      // True if bitposition of cvValue equals bitvalue
+};
+
+
+extern Dcc dcc;
+extern Accessory accCmd;
+extern Loco locoCmd;
+extern CvAccess cvCmd;
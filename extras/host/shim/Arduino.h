@@ -0,0 +1,120 @@
+//******************************************************************************************************
+//
+// file:      Arduino.h (host shim)
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//            2026-10-18 V1.1 ap: Simulated global interrupt flag
+//
+// purpose:   The subset of the Arduino API used by the decoder core, for a host (Linux) build.
+//
+// The clock, the pins and the ports are simulated; tests control them via HostShim.h. Since
+// __AVR__ is not defined, the core takes its non-AVR code paths (see boards.h and AP_DccFastPin.h).
+// The simulated processor has 8 ports (A..H) of 8 pins each: pin n is bit (n % 8) of port (n / 8).
+// digitalWrite() and the port registers are two views of the same simulated output latch.
+//
+//******************************************************************************************************
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH                0x1
+#define LOW                 0x0
+#define INPUT               0x0
+#define OUTPUT              0x1
+#define INPUT_PULLUP        0x2
+#define CHANGE              1
+#define FALLING             2
+#define RISING              3
+#define NOT_AN_INTERRUPT    -1
+#define LED_BUILTIN         13
+#define A0                  14
+
+#define F_CPU               16000000UL
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+
+#define bitRead(value, bit)            (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)             ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)           ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+// There are no interrupts on the host; ISRs are called directly by the tests. The global
+// interrupt flag is simulated, so tests can check which code runs with interrupts disabled.
+extern bool hostInterruptFlag;
+#define cli()               (hostInterruptFlag = false)
+#define sei()               (hostInterruptFlag = true)
+#define noInterrupts()      cli()
+#define interrupts()        sei()
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+int analogRead(uint8_t pin);
+
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+volatile uint8_t *portOutputRegister(uint8_t port);
+volatile uint8_t *portInputRegister(uint8_t port);
+volatile uint8_t *portModeRegister(uint8_t port);
+
+int digitalPinToInterrupt(uint8_t pin);
+void attachInterrupt(uint8_t interruptNum, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+
+//******************************************************************************************************
+// Print / Stream / Serial. Output is collected in a buffer, input is supplied by the test.
+//******************************************************************************************************
+class Print {
+  public:
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    virtual int availableForWrite(void) {return 0;}
+    virtual void flush(void) {}
+    size_t print(const char *s);
+    size_t print(long n);
+    size_t print(unsigned long n);
+    size_t print(int n) {return print((long)n);}
+    size_t print(unsigned int n) {return print((unsigned long)n);}
+    size_t print(double n, int digits = 2);
+    size_t println(void) {return print("\r\n");}
+    template <typename T> size_t println(T value) {return print(value) + println();}
+    virtual ~Print() {}
+};
+
+
+class Stream : public Print {
+  public:
+    virtual int available(void) = 0;
+    virtual int read(void) = 0;
+    virtual int peek(void) = 0;
+};
+
+
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baud) {(void)baud;}
+    operator bool() {return true;}
+    size_t write(uint8_t c);
+    using Print::write;
+    int availableForWrite(void);
+    int available(void);
+    int read(void);
+    int peek(void);
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,25 @@
+//******************************************************************************************************
+//
+// file:      EEPROM.h (host shim)
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Simulated EEPROM of hostEepromSize bytes, for the host build. A fresh EEPROM reads
+//            0xFF. Writes are counted, and accesses outside the EEPROM are recorded (HostShim.h).
+//
+//******************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define hostEepromSize    1024        // As the ATMega328 (UNO)
+
+
+class EEPROMClass {
+  public:
+    uint8_t read(int idx);
+    void write(int idx, uint8_t value);
+    void update(int idx, uint8_t value);  // Only writes if the value differs
+    uint16_t length(void) {return hostEepromSize;}
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,405 @@
+//******************************************************************************************************
+//
+// file:      HostShim.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//            2026-10-18 V1.1 ap: hostScheduleInput() and hostRebootHook, for the fuzz harness
+//            2026-10-18 V1.2 ap: hostInterruptFlag
+//            2026-10-18 V1.3 ap: hostDccPacket(): DCC packets are decoded into commands
+//            2026-10-18 V1.4 ap: hostRsbusChecks
+//
+// purpose:   Simulated clock, pins, EEPROM, Serial, DCC and RS-Bus for the host build.
+//            See HostShim.h for how tests control them.
+//
+//******************************************************************************************************
+#include <stdio.h>
+#include "HostShim.h"
+
+
+//******************************************************************************************************
+// State of the simulated hardware
+//******************************************************************************************************
+static unsigned long hostMicros;            // The simulated clock
+bool hostInterruptFlag;                     // Global interrupt flag (SREG I bit)
+bool hostAutoTick;
+
+static uint8_t portOut[hostPins / 8];       // Output latches (PORTx)
+static uint8_t portIn[hostPins / 8];        // Levels of the input pins (PINx)
+static uint8_t portMode[hostPins / 8];      // Direction (DDRx), 1 is output
+static uint8_t pullup[hostPins / 8];        // INPUT_PULLUP
+static int analogOut[hostPins];
+static bool inputScheduled;                 // hostScheduleInput()
+static uint8_t scheduledPin;
+static uint8_t scheduledLevel;
+static unsigned long scheduledMillis;
+int hostAnalogValue[hostPins];
+
+uint8_t hostEeprom[hostEepromSize];
+unsigned long hostEepromWrites;
+unsigned long hostEepromOutOfRange;
+
+static bool dccPending;
+static Dcc::CmdType_t dccQueued;
+unsigned long hostDccAcks;
+unsigned int hostAccessoryAddress;
+unsigned int hostLocoAddress;
+
+hostRsbusByte_t hostRsbusSent[hostBufferSize];
+uint16_t hostRsbusCount;
+unsigned long hostRsbusChecks;
+
+static uint8_t serialInput[hostBufferSize];
+static uint16_t serialHead;
+static uint16_t serialTail;
+uint8_t hostSerialOutput[hostBufferSize];
+uint16_t hostSerialCount;
+
+unsigned long hostReboots;
+void (*hostRebootHook)(void);
+
+// The objects the AP_DCC_library and the RSbus library instantiate
+Dcc dcc;
+Accessory accCmd;
+Loco locoCmd;
+CvAccess cvCmd;
+RSbusHardware rsbusHardware;
+EEPROMClass EEPROM;
+HardwareSerial Serial;
+
+
+void hostReset(void) {
+  hostMicros = 0;
+  hostInterruptFlag = true;
+  hostAutoTick = false;
+  memset(portOut, 0, sizeof(portOut));
+  memset(portIn, 0xFF, sizeof(portIn));
+  memset(portMode, 0, sizeof(portMode));
+  memset(pullup, 0, sizeof(pullup));
+  inputScheduled = false;
+  for (uint8_t i = 0; i < hostPins; i++) {
+    analogOut[i] = -1;
+    hostAnalogValue[i] = 0;
+  }
+  memset(hostEeprom, 0xFF, sizeof(hostEeprom));
+  hostEepromWrites = 0;
+  hostEepromOutOfRange = 0;
+  dccPending = false;
+  hostDccAcks = 0;
+  hostAccessoryAddress = 0;
+  hostLocoAddress = 0;
+  memset(&dcc, 0, sizeof(dcc));
+  memset(&accCmd, 0, sizeof(accCmd));
+  memset(&cvCmd, 0, sizeof(cvCmd));
+  memset(&rsbusHardware, 0, sizeof(rsbusHardware));
+  hostRsbusCount = 0;
+  hostRsbusChecks = 0;
+  serialHead = 0;
+  serialTail = 0;
+  hostSerialCount = 0;
+  hostReboots = 0;
+  hostRebootHook = nullptr;
+}
+
+
+//******************************************************************************************************
+// Clock
+//******************************************************************************************************
+unsigned long millis(void) {
+  if (hostAutoTick) hostMicros += 1000;
+  unsigned long now = hostMicros / 1000;
+  if (inputScheduled && (now >= scheduledMillis)) {
+    inputScheduled = false;
+    hostSetInput(scheduledPin, scheduledLevel);
+  }
+  return now;
+}
+
+unsigned long micros(void) {return hostMicros;}
+void delay(unsigned long ms) {hostMicros += ms * 1000;}
+void delayMicroseconds(unsigned int us) {hostMicros += us;}
+void hostAdvance(unsigned long ms) {hostMicros += ms * 1000;}
+void hostAdvanceMicros(unsigned long us) {hostMicros += us;}
+
+
+//******************************************************************************************************
+// Pins and ports
+//******************************************************************************************************
+uint8_t digitalPinToPort(uint8_t pin) {return (pin / 8) % (hostPins / 8);}
+uint8_t digitalPinToBitMask(uint8_t pin) {return 1 << (pin % 8);}
+volatile uint8_t *portOutputRegister(uint8_t port) {return &portOut[port];}
+volatile uint8_t *portInputRegister(uint8_t port) {return &portIn[port];}
+volatile uint8_t *portModeRegister(uint8_t port) {return &portMode[port];}
+
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  uint8_t port = digitalPinToPort(pin);
+  uint8_t mask = digitalPinToBitMask(pin);
+  if (mode == OUTPUT) portMode[port] |= mask;
+  else portMode[port] &= ~mask;
+  if (mode == INPUT_PULLUP) pullup[port] |= mask;
+  else pullup[port] &= ~mask;
+}
+
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  uint8_t port = digitalPinToPort(pin);
+  uint8_t mask = digitalPinToBitMask(pin);
+  if (value) portOut[port] |= mask;
+  else portOut[port] &= ~mask;
+  analogOut[pin % hostPins] = -1;
+}
+
+
+int digitalRead(uint8_t pin) {
+  uint8_t port = digitalPinToPort(pin);
+  uint8_t mask = digitalPinToBitMask(pin);
+  if (portMode[port] & mask) return (portOut[port] & mask) ? HIGH : LOW;
+  return (portIn[port] & mask) ? HIGH : LOW;
+}
+
+
+void analogWrite(uint8_t pin, int value) {
+  digitalWrite(pin, (value > 127) ? HIGH : LOW);
+  analogOut[pin % hostPins] = value;
+}
+
+
+int analogRead(uint8_t pin) {return hostAnalogValue[pin % hostPins];}
+
+
+void hostSetInput(uint8_t pin, uint8_t level) {
+  uint8_t port = digitalPinToPort(pin);
+  uint8_t mask = digitalPinToBitMask(pin);
+  if (level) portIn[port] |= mask;
+  else portIn[port] &= ~mask;
+}
+
+
+void hostScheduleInput(uint8_t pin, uint8_t level, unsigned long atMillis) {
+  scheduledPin = pin;
+  scheduledLevel = level;
+  scheduledMillis = atMillis;
+  inputScheduled = true;
+}
+
+
+uint8_t hostPinMode(uint8_t pin) {
+  uint8_t port = digitalPinToPort(pin);
+  uint8_t mask = digitalPinToBitMask(pin);
+  if (portMode[port] & mask) return OUTPUT;
+  return (pullup[port] & mask) ? INPUT_PULLUP : INPUT;
+}
+
+
+int hostAnalogWrite(uint8_t pin) {return analogOut[pin % hostPins];}
+
+// Interrupts are not simulated; tests call the ISRs directly
+int digitalPinToInterrupt(uint8_t pin) {return (pin == 2) ? 0 : (pin == 3) ? 1 : NOT_AN_INTERRUPT;}
+void attachInterrupt(uint8_t interruptNum, void (*isr)(void), int mode) {(void)interruptNum; (void)isr; (void)mode;}
+void detachInterrupt(uint8_t interruptNum) {(void)interruptNum;}
+
+long random(long howbig) {return (howbig > 0) ? (rand() % howbig) : 0;}
+long random(long howsmall, long howbig) {return (howbig > howsmall) ? howsmall + random(howbig - howsmall) : howsmall;}
+
+
+//******************************************************************************************************
+// EEPROM
+//******************************************************************************************************
+uint8_t EEPROMClass::read(int idx) {
+  if ((idx < 0) || (idx >= hostEepromSize)) {hostEepromOutOfRange++; return 0xFF;}
+  return hostEeprom[idx];
+}
+
+
+void EEPROMClass::write(int idx, uint8_t value) {
+  if ((idx < 0) || (idx >= hostEepromSize)) {hostEepromOutOfRange++; return;}
+  hostEeprom[idx] = value;
+  hostEepromWrites++;
+}
+
+
+void EEPROMClass::update(int idx, uint8_t value) {
+  if ((idx >= 0) && (idx < hostEepromSize) && (hostEeprom[idx] == value)) return;
+  write(idx, value);
+}
+
+
+//******************************************************************************************************
+// Serial
+//******************************************************************************************************
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::print(const char *s) {return write((const uint8_t *)s, strlen(s));}
+
+size_t Print::print(long n) {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%ld", n);
+  return print(buffer);
+}
+
+size_t Print::print(unsigned long n) {
+  char buffer[24];
+  snprintf(buffer, sizeof(buffer), "%lu", n);
+  return print(buffer);
+}
+
+size_t Print::print(double n, int digits) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.*f", digits, n);
+  return print(buffer);
+}
+
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (hostSerialCount >= hostBufferSize) return 0;
+  hostSerialOutput[hostSerialCount++] = c;
+  return 1;
+}
+
+int HardwareSerial::availableForWrite(void) {return hostBufferSize - hostSerialCount;}
+int HardwareSerial::available(void) {return serialTail - serialHead;}
+int HardwareSerial::read(void) {return (serialHead < serialTail) ? serialInput[serialHead++] : -1;}
+int HardwareSerial::peek(void) {return (serialHead < serialTail) ? serialInput[serialHead] : -1;}
+
+
+void hostSerialInput(const uint8_t *data, uint16_t size) {
+  if (serialHead == serialTail) serialHead = serialTail = 0;
+  while (size-- && (serialTail < hostBufferSize)) serialInput[serialTail++] = *data++;
+}
+
+
+//******************************************************************************************************
+// DCC
+//******************************************************************************************************
+void Dcc::attach(uint8_t dccPin, uint8_t ackPin) {(void)dccPin; pinMode(ackPin, OUTPUT);}
+void Dcc::detach(void) {dccPending = false;}
+
+bool Dcc::input(void) {
+  if (!dccPending) return false;
+  dccPending = false;
+  cmdType = dccQueued;
+  return true;
+}
+
+void Dcc::sendAck(void) {hostDccAcks++;}
+void Accessory::setMyAddress(unsigned int address) {hostAccessoryAddress = address;}
+void Loco::setMyAddress(unsigned int address) {hostLocoAddress = address;}
+
+
+uint8_t CvAccess::writeBit(uint8_t cvValue) {
+  if (bitvalue) return cvValue | (1 << bitposition);
+  return cvValue & ~(1 << bitposition);
+}
+
+
+bool CvAccess::verifyBit(uint8_t cvValue) {
+  return (((cvValue >> bitposition) & 0x01) == bitvalue);
+}
+
+
+void hostDccCommand(Dcc::CmdType_t cmdType) {
+  dccQueued = cmdType;
+  dccPending = true;
+}
+
+
+// Decodes the instruction bytes of a CV access packet (long form): 1110CCVV VVVVVVVV DDDDDDDD in
+// operations mode, 0111CCVV VVVVVVVV DDDDDDDD in service mode (RCN-214, RCN-216)
+static void decodeCvAccess(const uint8_t *instruction) {
+  cvCmd.operation = (CvAccess::CvOperation_t)((instruction[0] >> 2) & 0x03);
+  cvCmd.number = (((instruction[0] & 0x03) << 8) | instruction[1]) + 1;
+  cvCmd.value = instruction[2];
+  cvCmd.writecmd = bitRead(instruction[2], 4);
+  cvCmd.bitvalue = bitRead(instruction[2], 3);
+  cvCmd.bitposition = instruction[2] & 0x07;
+}
+
+
+// As the AP_DCC_library: basic accessory commands (RCN-213) and CV access commands, in operations
+// mode for a loco address (PoM) and on the programming track (SM). Accessory commands are compared
+// with the address given to accCmd.setMyAddress() as decoder address; PoM commands with the address
+// given to locoCmd.setMyAddress().
+bool hostDccPacket(const uint8_t *packet, uint8_t size, bool serviceMode) {
+  if (size < 3) return false;
+  uint8_t check = 0;
+  for (uint8_t i = 0; i < size; i++) check ^= packet[i];
+  if (check) {
+    dcc.errorXOR++;
+    return false;
+  }
+  size--;                                         // Without the error detection byte
+  if (serviceMode) {
+    if ((size != 3) || ((packet[0] & 0xF0) != 0x70)) return false;
+    decodeCvAccess(packet);
+    hostDccCommand(Dcc::SmCmd);
+    return true;
+  }
+  if ((packet[0] & 0xC0) == 0x80) {
+    // Basic accessory: 10AAAAAA 1AAADAAR, the high address bits are inverted
+    if ((size != 2) || !(packet[1] & 0x80)) return false;
+    unsigned int address = (packet[0] & 0x3F) | ((~packet[1] & 0x70) << 2);
+    if (address == 0) return false;
+    accCmd.command = Accessory::basic;
+    accCmd.decoderAddress = address - 1;
+    accCmd.turnout = ((packet[1] >> 1) & 0x03) + 1;
+    accCmd.outputAddress = (accCmd.decoderAddress * 4) + accCmd.turnout;
+    accCmd.position = packet[1] & 0x01;
+    accCmd.activate = bitRead(packet[1], 3);
+    hostDccCommand((accCmd.decoderAddress == hostAccessoryAddress) ? Dcc::MyAccessoryCmd
+                                                                   : Dcc::AnyAccessoryCmd);
+    return true;
+  }
+  // Loco address: short (0AAAAAAA) or long (11AAAAAA AAAAAAAA)
+  unsigned int address;
+  uint8_t first;                                  // First instruction byte
+  if ((packet[0] & 0xC0) == 0xC0) {
+    address = ((packet[0] & 0x3F) << 8) | packet[1];
+    first = 2;
+  }
+  else if (!(packet[0] & 0x80)) {
+    address = packet[0];
+    first = 1;
+  }
+  else return false;
+  if ((size != first + 3) || ((packet[first] & 0xF0) != 0xE0)) return false;
+  decodeCvAccess(&packet[first]);
+  hostDccCommand((address == hostLocoAddress) ? Dcc::MyPomCmd : Dcc::AnyPomCmd);
+  return true;
+}
+
+
+//******************************************************************************************************
+// RS-Bus
+//******************************************************************************************************
+void RSbusHardware::attach(uint8_t usartNumber, uint8_t rxPin) {(void)usartNumber; pinMode(rxPin, INPUT);}
+void RSbusHardware::detach(void) {}
+void RSbusHardware::checkPolling(void) {}
+void RSbusConnection::checkConnection(void) {hostRsbusChecks++;}
+
+
+void RSbusConnection::send4bits(uint8_t nibble, uint8_t value) {
+  send8bits((nibble << 4) | (value & 0x0F));
+}
+
+
+void RSbusConnection::send8bits(uint8_t value) {
+  feedbackRequested = false;
+  if (hostRsbusCount >= hostBufferSize) return;
+  hostRsbusSent[hostRsbusCount].address = address;
+  hostRsbusSent[hostRsbusCount].value = value;
+  hostRsbusCount++;
+}
+
+
+//******************************************************************************************************
+// Reboot
+//******************************************************************************************************
+// The program can not be restarted on the host. Without a hook, Processor::reboot() returns.
+void hostReboot(void) {
+  hostReboots++;
+  if (hostRebootHook != nullptr) hostRebootHook();
+}
@@ -0,0 +1,90 @@
+//******************************************************************************************************
+//
+// file:      HostShim.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//            2026-10-18 V1.1 ap: hostScheduleInput() and hostRebootHook, for the fuzz harness
+//            2026-10-18 V1.2 ap: hostInterruptFlag
+//            2026-10-18 V1.3 ap: hostDccPacket(): DCC packets are decoded into commands
+//            2026-10-18 V1.4 ap: hostRsbusChecks
+//
+// purpose:   Lets host tests control and inspect the simulated hardware of the Arduino shim.
+//
+// - Interrupts: hostInterruptFlag (declared in Arduino.h) is the global interrupt flag; cli(),
+//   sei(), noInterrupts() and interrupts() change it. It is set (interrupts enabled) at reset.
+// - Clock: millis() and micros() return the simulated time; it only changes via hostAdvance()
+//   or delay(). hostAutoTick makes every millis() call advance the clock by 1 ms, for code that
+//   waits in a loop for the time to pass.
+// - Pins: hostSetInput() sets the level an input pin reads (initially HIGH, as with a pull-up);
+//   outputs read back what was written. hostScheduleInput() changes an input once the clock
+//   reaches a given time, for code that waits in a loop for a pin to change.
+// - EEPROM: the contents, the number of writes and the number of out of range accesses.
+// - DCC: hostDccCommand() queues a command for dcc.input(), with the fields of accCmd / cvCmd set
+//   by the test. hostDccPacket() instead decodes a DCC packet (including the error detection
+//   byte) into these fields, and queues the resulting command. Acks and addresses are recorded.
+// - RS-Bus: the bytes sent, for the decoder address and for PoM feedback.
+// - Serial: the bytes written, and the bytes the next reads return.
+// - Reboot: Processor::reboot() calls hostReboot(), which counts the reboots. If hostRebootHook
+//   is set, it is called next; a test may longjmp() from there to restart its decoder. Otherwise
+//   hostReboot() returns.
+//
+// hostReset() brings everything back to the power-on state: time 0, all pins inputs, a fresh
+// (erased) EEPROM and empty buffers.
+//
+//******************************************************************************************************
+#pragma once
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <AP_DCC_library.h>
+#include <RSbus.h>
+
+#define hostPins          64          // 8 ports of 8 pins
+#define hostBufferSize    256         // Serial and RS-Bus buffers
+
+
+void hostReset(void);
+
+// Clock
+void hostAdvance(unsigned long ms);
+void hostAdvanceMicros(unsigned long us);
+extern bool hostAutoTick;
+
+// Pins
+void hostSetInput(uint8_t pin, uint8_t level);
+void hostScheduleInput(uint8_t pin, uint8_t level, unsigned long atMillis);  // Replaces a pending change
+uint8_t hostPinMode(uint8_t pin);
+int hostAnalogWrite(uint8_t pin);     // Last analogWrite() value, or -1 after digitalWrite()
+extern int hostAnalogValue[hostPins]; // What analogRead() returns
+
+// EEPROM
+extern uint8_t hostEeprom[hostEepromSize];
+extern unsigned long hostEepromWrites;    // Bytes actually written (update() skips equal values)
+extern unsigned long hostEepromOutOfRange;
+
+// DCC
+void hostDccCommand(Dcc::CmdType_t cmdType);
+// serviceMode: the packet is received on the programming track. Returns true if a command was
+// queued; packets with an error, or of a type the core does not use, are ignored.
+bool hostDccPacket(const uint8_t *packet, uint8_t size, bool serviceMode = false);
+extern unsigned long hostDccAcks;
+extern unsigned int hostAccessoryAddress; // Set by accCmd.setMyAddress()
+extern unsigned int hostLocoAddress;      // Set by locoCmd.setMyAddress()
+
+// RS-Bus
+struct hostRsbusByte_t {
+  uint8_t address;
+  uint8_t value;
+};
+extern hostRsbusByte_t hostRsbusSent[hostBufferSize];
+extern uint16_t hostRsbusCount;
+extern unsigned long hostRsbusChecks;    // Calls of checkConnection()
+
+// Serial
+void hostSerialInput(const uint8_t *data, uint16_t size);
+extern uint8_t hostSerialOutput[hostBufferSize];
+extern uint16_t hostSerialCount;
+
+// Reboot
+void hostReboot(void);
+extern unsigned long hostReboots;
+extern void (*hostRebootHook)(void);
@@ -0,0 +1,38 @@
+//******************************************************************************************************
+//
+// file:      RSbus.h (host shim)
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Stand-ins for the objects of the RSbus library, for the host build.
+//
+// There is no RS-Bus master: a test sets feedbackRequested when the master asks for feedback.
+// The bytes handed to send8bits() are recorded in hostRsbusSent (see HostShim.h).
+//
+//******************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+
+class RSbusHardware {
+  public:
+    bool swapUsartPin;
+    uint8_t parityErrors;             // Set by the test
+    uint8_t pulseCountErrors;         // Set by the test
+    void attach(uint8_t usartNumber, uint8_t rxPin);
+    void detach(void);
+    void checkPolling(void);
+};
+
+
+class RSbusConnection {
+  public:
+    uint8_t address;                  // 1..128
+    bool feedbackRequested;           // Set by the test; cleared by send8bits()
+    void checkConnection(void);
+    void send4bits(uint8_t nibble, uint8_t value);
+    void send8bits(uint8_t value);
+};
+
+
+extern RSbusHardware rsbusHardware;
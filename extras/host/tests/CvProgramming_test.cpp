@@ -0,0 +1,151 @@
+//******************************************************************************************************
+//
+// file:      CvProgramming_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//            2026-10-18 V1.1 ap: readCv()
+//
+// purpose:   Host tests for CvProgramming: SM and PoM byte and bit access, and the special CVs.
+//
+//******************************************************************************************************
+#include "AP_DCC_Decoder_Core.h"
+#include "HostTest.h"
+
+
+static void startDecoder(void) {
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  decoderHardware.init();
+  hostEepromWrites = 0;
+}
+
+
+static void cvCommand(Dcc::CmdType_t cmdType, CvAccess::CvOperation_t operation,
+                      unsigned int number, uint8_t value) {
+  cvCmd.operation = operation;
+  cvCmd.number = number;
+  cvCmd.value = value;
+  cvProgramming.processMessage(cmdType);
+}
+
+
+static void bitCommand(bool write, unsigned int number, uint8_t bitposition, uint8_t bitvalue) {
+  cvCmd.operation = CvAccess::bitManipulation;
+  cvCmd.number = number;
+  cvCmd.writecmd = write;
+  cvCmd.bitposition = bitposition;
+  cvCmd.bitvalue = bitvalue;
+  cvProgramming.processMessage(Dcc::SmCmd);
+}
+
+
+TEST(smWriteAndVerifyByte) {
+  startDecoder();
+  cvCommand(Dcc::SmCmd, CvAccess::writeByte, T_on_F1, 42);
+  CHECK_EQ(cvValues.read(T_on_F1), 42);
+  CHECK_EQ(hostDccAcks, 1);
+  cvCommand(Dcc::SmCmd, CvAccess::verifyByte, T_on_F1, 41);
+  CHECK_EQ(hostDccAcks, 1);
+  cvCommand(Dcc::SmCmd, CvAccess::verifyByte, T_on_F1, 42);
+  CHECK_EQ(hostDccAcks, 2);
+}
+
+
+TEST(smWriteAndVerifyBit) {
+  startDecoder();
+  cvCommand(Dcc::SmCmd, CvAccess::writeByte, T_on_F1, 0);
+  bitCommand(true, T_on_F1, 2, 1);
+  CHECK_EQ(cvValues.read(T_on_F1), 0x04);
+  unsigned long acks = hostDccAcks;
+  bitCommand(false, T_on_F1, 2, 1);
+  CHECK_EQ(hostDccAcks, acks + 1);
+  bitCommand(false, T_on_F1, 3, 1);
+  CHECK_EQ(hostDccAcks, acks + 1);
+}
+
+
+TEST(pomVerifyAnswersViaRsbus) {
+  startDecoder();
+  cvCommand(Dcc::MyPomCmd, CvAccess::writeByte, T_on_F2, 7);
+  CHECK_EQ(hostDccAcks, 0);
+  cvCommand(Dcc::MyPomCmd, CvAccess::verifyByte, T_on_F2, 0);
+  CHECK_EQ(hostRsbusCount, 1);
+  CHECK_EQ(hostRsbusSent[0].address, 128);
+  CHECK_EQ(hostRsbusSent[0].value, 7);
+}
+
+
+TEST(versionIsReadOnly) {
+  startDecoder();
+  uint8_t before = cvValues.read(version);
+  cvCommand(Dcc::SmCmd, CvAccess::writeByte, version, before + 1);
+  bitCommand(true, version, 0, !(before & 1));
+  CHECK_EQ(cvValues.read(version), before);
+}
+
+
+TEST(vidResetsAndReboots) {
+  startDecoder();
+  cvCommand(Dcc::SmCmd, CvAccess::writeByte, T_on_F1, 42);
+  cvCommand(Dcc::SmCmd, CvAccess::writeByte, VID, 0x0C);
+  CHECK_EQ(hostReboots, 0);
+  cvCommand(Dcc::SmCmd, CvAccess::writeByte, VID, 0x0D);
+  CHECK_EQ(hostReboots, 1);
+  CHECK_EQ(cvValues.read(T_on_F1), cvValues.defaults[T_on_F1]);
+}
+
+
+TEST(bitWriteToVidAlsoResets) {
+  startDecoder();
+  CHECK_EQ(cvValues.read(VID), 0x0D);
+  // The stored VID is 0x0D; clearing bit 0 and setting it again writes 0x0D
+  bitCommand(true, VID, 0, 0);
+  CHECK_EQ(hostReboots, 0);
+  bitCommand(true, VID, 0, 1);
+  CHECK_EQ(hostReboots, 1);
+}
+
+
+TEST(restartReboots) {
+  startDecoder();
+  cvCommand(Dcc::MyPomCmd, CvAccess::writeByte, Restart, 0);
+  CHECK_EQ(hostReboots, 0);
+  cvCommand(Dcc::MyPomCmd, CvAccess::writeByte, Restart, 1);
+  CHECK_EQ(hostReboots, 1);
+}
+
+
+TEST(cvZeroAndOutOfRangeAreRejected) {
+  startDecoder();
+  cvCommand(Dcc::SmCmd, CvAccess::writeByte, 0, 0);
+  CHECK(!cvValues.notInitialised());
+  cvCommand(Dcc::SmCmd, CvAccess::writeByte, hostEepromSize, 1);
+  cvCommand(Dcc::SmCmd, CvAccess::verifyByte, 0xFFFF, 1);
+  CHECK_EQ(hostEepromWrites, 0);
+  CHECK_EQ(hostEepromOutOfRange, 0);
+  CHECK_EQ(hostDccAcks, 0);
+}
+
+
+TEST(searchIsNotStored) {
+  startDecoder();
+  cvCommand(Dcc::MyPomCmd, CvAccess::writeByte, Search, 1);
+  CHECK_EQ(hostEepromWrites, 0);
+  cvCommand(Dcc::MyPomCmd, CvAccess::verifyByte, Search, 0);
+  CHECK_EQ(hostRsbusCount, 1);
+  CHECK_EQ(hostRsbusSent[0].value, 1);
+}
+
+
+TEST(readCvReturnsLiveValues) {
+  startDecoder();
+  dcc.errorXOR = 5;
+  rsbusHardware.parityErrors = 3;
+  rsbusHardware.pulseCountErrors = 4;
+  CHECK_EQ(cvProgramming.readCv(DccQuality), 5);
+  CHECK_EQ(cvProgramming.readCv(ParityErrors), 3);
+  CHECK_EQ(cvProgramming.readCv(PulseErrors), 4);
+  cvCommand(Dcc::MyPomCmd, CvAccess::writeByte, Search, 1);
+  CHECK_EQ(cvProgramming.readCv(Search), 1);
+  CHECK_EQ(cvProgramming.readCv(T_on_F1), cvValues.read(T_on_F1));
+}
@@ -0,0 +1,109 @@
+//******************************************************************************************************
+//
+// file:      CvValues_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Host tests for CvValues, and the staged start-up of decoderHardware.
+//
+//******************************************************************************************************
+#include "AP_DCC_Decoder_Core.h"
+#include "HostTest.h"
+
+
+static void runUpdates(unsigned int count) {
+  while (count--) {
+    decoderHardware.update();
+    hostAdvanceMicros(500);
+  }
+}
+
+
+TEST(freshEepromIsFilledIncrementally) {
+  cvValues.init(SwitchDecoder);
+  CHECK(cvValues.notInitialised());
+  decoderHardware.init();
+  CHECK(cvValues.filling());
+  CHECK(!decoderHardware.ready());
+  // Till the fill is complete, read() returns the defaults
+  CHECK_EQ(cvValues.read(DecType), SwitchDecoder);
+  CHECK_EQ(cvValues.read(myAddrH), 0x80);
+  runUpdates(2 * max_cvs);
+  CHECK(decoderHardware.ready());
+  CHECK(!cvValues.notInitialised());
+  CHECK_EQ(hostEeprom[DecType], SwitchDecoder);
+  CHECK(decoderHardware.readyTime >= decoderHardware.attachTime);
+}
+
+
+TEST(initialisedEepromIsNotFilledAgain) {
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  hostEepromWrites = 0;
+  decoderHardware.init();
+  CHECK(decoderHardware.ready());
+  CHECK(!cvValues.filling());
+  runUpdates(100);
+  CHECK_EQ(hostEepromWrites, 0);
+}
+
+
+TEST(writeDuringFillCompletesTheFillFirst) {
+  cvValues.init(SwitchDecoder);
+  cvValues.startDefaults();
+  cvValues.write(myRSAddr, 5);
+  CHECK(!cvValues.filling());
+  CHECK(!cvValues.notInitialised());
+  CHECK_EQ(cvValues.read(myRSAddr), 5);
+  CHECK_EQ(hostEeprom[myRSAddr], 5);
+}
+
+
+TEST(markerIsWrittenLast) {
+  cvValues.init(SwitchDecoder);
+  cvValues.startDefaults();
+  for (uint8_t i = 0; i < max_cvs; i++) {
+    cvValues.fillDefaults();
+    CHECK(cvValues.notInitialised());
+  }
+  CHECK(cvValues.fillDefaults());
+  CHECK(!cvValues.notInitialised());
+}
+
+
+TEST(storedAddress) {
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  CHECK(cvValues.addressNotSet());
+  // Decoder addressing: CV1 = 5, CV9 = 1 gives decoder address 64 + 5 - 1
+  cvValues.write(myAddrL, 5);
+  cvValues.write(myAddrH, 1);
+  CHECK(!cvValues.addressNotSet());
+  CHECK_EQ(cvValues.storedAddress(), 68);
+  // Output addressing: CV1 = 5, CV9 = 1 gives output address 5 + 256
+  cvValues.write(Config, cvValues.read(Config) | (1 << 6));
+  CHECK_EQ(cvValues.storedAddress(), 261);
+}
+
+
+TEST(noEepromAccessOutOfRange) {
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  for (uint16_t cv = 0; cv < hostEepromSize; cv++) cvValues.write(cv, cvValues.read(cv));
+  CHECK_EQ(hostEepromOutOfRange, 0);
+}
+
+
+TEST(eepromWritesCountsChangedBytes) {
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  uint16_t writes = cvValues.eepromWrites;
+  hostEepromWrites = 0;
+  cvValues.write(T_on_F1, cvValues.read(T_on_F1));      // Unchanged: not written
+  CHECK_EQ(cvValues.eepromWrites, writes);
+  cvValues.write(T_on_F1, cvValues.read(T_on_F1) + 1);
+  CHECK_EQ(cvValues.eepromWrites, writes + 1);
+  cvValues.setDefaults();
+  CHECK_EQ(cvValues.eepromWrites, writes + 2);
+  CHECK_EQ(hostEepromWrites, 2);
+}
@@ -0,0 +1,60 @@
+//******************************************************************************************************
+//
+// file:      DccButton_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Host tests for DccButton: debouncing and press / release times.
+//
+//******************************************************************************************************
+#include "AP_DccButton.h"
+#include "HostTest.h"
+
+#define testButtonPin   6
+
+
+TEST(pressAndRelease) {
+  DccButton button;
+  button.attach(testButtonPin);
+  CHECK_EQ(hostPinMode(testButtonPin), INPUT_PULLUP);
+  hostAdvance(100);
+  CHECK(!button.read());
+  hostSetInput(testButtonPin, LOW);   // Pressed (inverted logic)
+  CHECK(button.read());
+  CHECK(button.wasPressed());
+  hostAdvance(100);
+  hostSetInput(testButtonPin, HIGH);
+  CHECK(!button.read());
+  CHECK(button.wasReleased());
+}
+
+
+TEST(bouncesAreIgnored) {
+  DccButton button;
+  button.attach(testButtonPin, 25);
+  hostAdvance(100);
+  hostSetInput(testButtonPin, LOW);
+  CHECK(button.read());
+  hostAdvance(5);
+  hostSetInput(testButtonPin, HIGH);  // Bounce, within the debounce time
+  CHECK(button.read());
+  CHECK(!button.wasReleased());
+  hostAdvance(25);
+  CHECK(!button.read());
+}
+
+
+TEST(pressedForLongHold) {
+  DccButton button;
+  button.attach(testButtonPin);
+  hostAdvance(100);
+  hostSetInput(testButtonPin, LOW);
+  button.read();
+  hostAdvance(999);
+  button.read();
+  CHECK(!button.pressedFor(1000));
+  hostAdvance(70000);                 // Longer than 16 bits of milliseconds
+  button.read();
+  CHECK(button.pressedFor(1000));
+  CHECK(button.pressedFor(70000));
+}
@@ -0,0 +1,54 @@
+//******************************************************************************************************
+//
+// file:      DccCvSerial_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Host tests for DccCvSerial: a read block returns the same values as PoM feedback.
+//
+//******************************************************************************************************
+#include "AP_DCC_Decoder_Core.h"
+#include "AP_DccCvSerial.h"
+#include "HostTest.h"
+
+
+static uint16_t crc16(const uint8_t *data, uint8_t length) {
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+
+static void readBlock(DccCvSerial &cvSerial, unsigned int first, uint8_t len) {
+  uint8_t frame[7] = {0x7E, 'R', (uint8_t)(first & 0xFF), (uint8_t)(first >> 8), len};
+  uint16_t crc = crc16(&frame[1], 4);
+  frame[5] = crc & 0xFF;
+  frame[6] = crc >> 8;
+  hostSerialInput(frame, sizeof(frame));
+  for (uint8_t i = 0; i < 4; i++) cvSerial.update();
+}
+
+
+TEST(readBlockReturnsLiveValues) {
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  decoderHardware.init();
+  dcc.errorXOR = 5;
+  rsbusHardware.parityErrors = 3;
+  rsbusHardware.pulseCountErrors = 4;
+  DccCvSerial cvSerial;
+  cvSerial.attach(Serial);
+  readBlock(cvSerial, DccQuality, PulseErrors - DccQuality + 1);
+  // Sync, cmd, CV low, CV high, len, data, CRC
+  CHECK_EQ(hostSerialCount, 5 + (PulseErrors - DccQuality + 1) + 2);
+  CHECK_EQ(hostSerialOutput[1], 'r');
+  for (unsigned int cv = DccQuality; cv <= PulseErrors; cv++) {
+    CHECK_EQ(hostSerialOutput[5 + cv - DccQuality], cvProgramming.readCv(cv));
+  }
+  CHECK_EQ(hostSerialOutput[5], 5);
+  CHECK_EQ(hostSerialOutput[5 + ParityErrors - DccQuality], 3);
+  CHECK_EQ(hostSerialOutput[5 + PulseErrors - DccQuality], 4);
+}
@@ -0,0 +1,115 @@
+//******************************************************************************************************
+//
+// file:      DccFeedback_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Host tests for rsFeedback, as driven by decoderHardware.update(): feedback requests and
+//            RS-Bus connections on every call, changes, coalescing, RSFEC and PoM priority per tick.
+//
+//******************************************************************************************************
+#include "AP_DCC_Decoder_Core.h"
+#include "HostTest.h"
+
+#define firstRsAddress  10
+
+static DccFeedbackSlot slots[2];
+
+
+static void startFeedback(uint8_t fec) {
+  cvValues.init(SwitchDecoder);
+  cvValues.setDefaults();
+  cvValues.write(RSFEC, fec);
+  decoderHardware.init();
+  rsFeedback.attach(slots, 2, firstRsAddress);   // Window: 60ms = 3 ticks
+}
+
+
+static void runUpdates(unsigned long ms) {
+  while (ms--) {
+    hostAdvance(1);
+    decoderHardware.update();
+  }
+}
+
+
+TEST(feedbackRequestIsAnsweredOnTheNextUpdate) {
+  startFeedback(0);
+  runUpdates(20);                                 // Tick at 20ms: nothing changed
+  CHECK_EQ(hostRsbusCount, 0);
+  rsFeedback.set(1, 0x5A);
+  slots[1].connection.feedbackRequested = true;
+  runUpdates(1);                                  // 19ms before the next tick
+  CHECK_EQ(hostRsbusCount, 1);
+  CHECK_EQ(hostRsbusSent[0].address, firstRsAddress + 1);
+  CHECK_EQ(hostRsbusSent[0].value, 0x5A);
+  CHECK(decoderHardware.answerTime != 0);
+  runUpdates(200);                                // The requested state is not sent again
+  CHECK_EQ(hostRsbusCount, 1);
+}
+
+
+TEST(connectionsAreCheckedOnEveryUpdate) {
+  startFeedback(0);
+  decoderHardware.update();                       // No tick
+  CHECK_EQ(hostRsbusChecks, 3);                   // rsbusPom and both slots
+  decoderHardware.update();
+  CHECK_EQ(hostRsbusChecks, 6);
+}
+
+
+TEST(changesWaitForTheTick) {
+  startFeedback(0);
+  rsFeedback.setBit(3, true);
+  runUpdates(19);
+  CHECK_EQ(hostRsbusCount, 0);
+  runUpdates(1);
+  CHECK_EQ(hostRsbusCount, 1);
+  CHECK_EQ(hostRsbusSent[0].address, firstRsAddress);
+  CHECK_EQ(hostRsbusSent[0].value, 0x08);
+}
+
+
+TEST(changesWithinTheWindowAreCoalesced) {
+  startFeedback(0);
+  rsFeedback.set(0, 1);
+  runUpdates(21);                                 // Sent at 20ms
+  rsFeedback.set(0, 2);
+  runUpdates(9);
+  rsFeedback.set(0, 3);
+  runUpdates(49);                                 // 79ms
+  CHECK_EQ(hostRsbusCount, 1);
+  runUpdates(1);                                  // 80ms: the window has passed
+  CHECK_EQ(hostRsbusCount, 2);
+  CHECK_EQ(hostRsbusSent[1].value, 3);
+}
+
+
+TEST(changeAndChangeBackIsNotSent) {
+  startFeedback(0);
+  rsFeedback.set(0, 1);
+  rsFeedback.set(0, 0);
+  runUpdates(200);
+  CHECK_EQ(hostRsbusCount, 0);
+}
+
+
+TEST(repetitionsFollowRsfec) {
+  startFeedback(2);
+  rsFeedback.set(1, 7);
+  runUpdates(300);
+  CHECK_EQ(hostRsbusCount, 3);                    // 20ms, 80ms and 140ms
+  for (uint8_t i = 0; i < 3; i++) CHECK_EQ(hostRsbusSent[i].value, 7);
+}
+
+
+TEST(pomAnswerPostponesChanges) {
+  startFeedback(0);
+  rsFeedback.defer();
+  rsFeedback.set(0, 1);
+  runUpdates(59);
+  CHECK_EQ(hostRsbusCount, 0);
+  runUpdates(1);                                  // Third tick
+  CHECK_EQ(hostRsbusCount, 1);
+}
+
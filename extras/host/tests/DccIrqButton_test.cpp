@@ -0,0 +1,52 @@
+//******************************************************************************************************
+//
+// file:      DccIrqButton_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Host tests for DccIrqButton: the edge queue holds irqQueueSize edges.
+//
+// Interrupts are not simulated: after each change of the input the test calls isr() itself.
+// The button objects are static, since attach() registers at most maxIrqButtons buttons.
+//
+//******************************************************************************************************
+#include "AP_DccIrqButton.h"
+#include "HostTest.h"
+
+#define testIrqPin      2             // digitalPinToInterrupt() of the shim: pins 2 and 3
+
+static DccIrqButton button;
+
+
+static void edge(DccIrqButton &irqButton, uint8_t level) {
+  hostSetInput(testIrqPin, level);
+  irqButton.isr();
+  hostAdvance(30);                    // Longer than the debounce time
+}
+
+
+TEST(queueHoldsAllEdges) {
+  hostSetInput(testIrqPin, HIGH);
+  CHECK(button.attach(testIrqPin));
+  hostAdvance(100);
+  // irqQueueSize edges (irqQueueSize / 2 presses), without any query in between
+  for (uint8_t i = 0; i < irqQueueSize / 2; i++) {
+    edge(button, LOW);
+    edge(button, HIGH);
+  }
+  // The last edge is queued as well: the release time is its time, not the time of a resync
+  hostAdvance(1000);
+  CHECK(button.releasedFor(1000));
+  uint8_t presses = 0;
+  while (button.wasPressed()) presses++;
+  CHECK_EQ(presses, irqQueueSize / 2);
+  uint8_t releases = 0;
+  while (button.wasReleased()) releases++;
+  CHECK_EQ(releases, irqQueueSize / 2);
+}
+
+
+TEST(pinWithoutInterruptIsRejected) {
+  DccIrqButton other;
+  CHECK(!other.attach(6));
+}
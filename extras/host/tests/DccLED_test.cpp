@@ -0,0 +1,61 @@
+//******************************************************************************************************
+//
+// file:      DccLED_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Host tests for the LED classes.
+//
+//******************************************************************************************************
+#include "AP_DccLED.h"
+#include "HostTest.h"
+
+#define testLedPin    4
+
+
+// Calls update() every 10ms for the given time, and returns how many samples the LED was on
+static unsigned int onSamples(FlashLed &led, unsigned long ms) {
+  unsigned int count = 0;
+  for (unsigned long t = 0; t < ms; t += 10) {
+    hostAdvance(10);
+    led.update();
+    if (digitalRead(testLedPin)) count++;
+  }
+  return count;
+}
+
+
+TEST(basicOnOffAndInvert) {
+  BasicLed led;
+  led.attach(testLedPin);
+  CHECK_EQ(hostPinMode(testLedPin), OUTPUT);
+  led.turn_on();
+  CHECK_EQ(digitalRead(testLedPin), HIGH);
+  led.toggle();
+  CHECK_EQ(digitalRead(testLedPin), LOW);
+  led.attach(testLedPin, true);
+  led.turn_on();
+  CHECK_EQ(digitalRead(testLedPin), LOW);
+  CHECK(led.ledIsOn());
+}
+
+
+TEST(flashFastKeepsFlashing) {
+  FlashLed led;
+  led.attach(testLedPin);
+  led.flashFast();
+  // 100ms on, 200ms off: a third of the time on
+  unsigned int on = onSamples(led, 3000);
+  CHECK(on >= 90);
+  CHECK(on <= 110);
+}
+
+
+TEST(singleFlashStops) {
+  DccLed led;
+  led.attach(testLedPin);
+  led.feedback();
+  CHECK_EQ(digitalRead(testLedPin), HIGH);
+  CHECK(onSamples(led, 2000) <= 50);
+  CHECK_EQ(onSamples(led, 1000), 0);
+}
@@ -0,0 +1,96 @@
+//******************************************************************************************************
+//
+// file:      DccOneShot_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Host tests for DccOneShot without hardware timer (DCC_CORE_ONESHOT is 0): callbacks
+//            are called from update(), with interrupts enabled, and the jitter is bounded by the
+//            time between two update() calls.
+//
+//******************************************************************************************************
+#include "AP_DccOneShot.h"
+#include "HostTest.h"
+
+#define loopTime        20            // Simulated duration of the main loop (us)
+
+static DccOneShot shot;
+static DccOneShot other;
+static unsigned long firedAt;
+static unsigned long calls;
+static bool interruptsInCallback;
+
+
+static void record(void) {
+  firedAt = micros();
+  calls++;
+  interruptsInCallback = hostInterruptFlag;
+}
+
+
+static void stopOther(void) {
+  record();
+  other.stop();
+}
+
+
+// Runs the main loop for the given time
+static void runLoop(unsigned long us) {
+  unsigned long end = micros() + us;
+  while ((long)(micros() - end) < 0) {
+    DccOneShot::update();
+    hostAdvanceMicros(loopTime);
+  }
+}
+
+
+TEST(callbackRunsWithInterruptsEnabled) {
+  calls = 0;
+  shot.start(100, record);
+  runLoop(200);
+  CHECK_EQ(calls, 1);
+  CHECK(interruptsInCallback);
+  CHECK(hostInterruptFlag);
+  CHECK(!shot.running());
+}
+
+
+TEST(updateKeepsInterruptsDisabled) {
+  calls = 0;
+  shot.start(100, record);
+  hostAdvanceMicros(200);
+  noInterrupts();
+  DccOneShot::update();
+  CHECK_EQ(calls, 1);
+  CHECK(!interruptsInCallback);       // The caller's state
+  CHECK(!hostInterruptFlag);
+  interrupts();
+}
+
+
+TEST(jitterIsBoundedByTheLoopTime) {
+  const unsigned long delays[] = {1, 50, 333, 1000, 12345, 100000};
+  unsigned long worst = 0;
+  for (uint8_t i = 0; i < sizeof(delays) / sizeof(delays[0]); i++) {
+    calls = 0;
+    hostAdvanceMicros(i * 7);         // Start at different phases of the loop
+    unsigned long start = micros();
+    shot.start(delays[i], record);
+    runLoop(delays[i] + 3 * loopTime);
+    CHECK_EQ(calls, 1);
+    unsigned long late = firedAt - (start + delays[i]);
+    CHECK(late <= loopTime);          // Never early, at most one loop late
+    if (late > worst) worst = late;
+  }
+  printf("  worst case lateness: %lu us (loop time %u us)\n", worst, loopTime);
+}
+
+
+TEST(callbackMayStopAnotherTimer) {
+  calls = 0;
+  shot.start(100, stopOther);
+  other.start(500, record);
+  runLoop(1000);
+  CHECK_EQ(calls, 1);
+  CHECK(!other.running());
+}
@@ -0,0 +1,288 @@
+//******************************************************************************************************
+//
+// file:      DccRelay_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//            2026-10-18 V1.1 ap: A restored mono-stable relay does not release the scheduler
+//            2026-10-18 V1.2 ap: DccRoundRobin: modes 0..3, RInter stepping and the change callback
+//
+// purpose:   Host tests for relayClass (bi-stable relays and coils), DccRelayBank and DccRoundRobin.
+//
+//******************************************************************************************************
+#include "AP_DccRelay.h"
+#include "AP_DccRelayBank.h"
+#include "AP_DccCoilScheduler.h"
+#include "AP_DccStateStore.h"
+#include "HostTest.h"
+
+#define coil1Pin    8
+#define coil2Pin    9
+#define bankPin1    16                // First pin of port C: relays 1..8
+#define bankPin9    0                 // First pin of port A: relays 9..16
+
+
+static void runUpdates(relayClass &relay, unsigned long ms) {
+  while (ms--) {
+    hostAdvance(1);
+    relay.update();
+  }
+}
+
+
+TEST(coilIsSwitchedOffAfterHoldTime) {
+  relayClass relay;
+  relay.init(coil1Pin, coil2Pin, 3); // 60ms
+  relay.activate(relayClass::POS1);
+  CHECK_EQ(digitalRead(coil1Pin), HIGH);
+  CHECK_EQ(digitalRead(coil2Pin), LOW);
+  runUpdates(relay, 59);
+  CHECK_EQ(digitalRead(coil1Pin), HIGH);
+  runUpdates(relay, 1);
+  CHECK_EQ(digitalRead(coil1Pin), LOW);
+  CHECK_EQ(relay.state, relayClass::POS1);
+}
+
+
+TEST(commandDuringHoldTimeIsPending) {
+  relayClass relay;
+  relay.init(coil1Pin, coil2Pin, 3);
+  relay.activate(relayClass::POS1);
+  hostAdvance(10);
+  relay.activate(relayClass::POS2);
+  CHECK_EQ(digitalRead(coil2Pin), LOW);
+  runUpdates(relay, 50);
+  CHECK_EQ(digitalRead(coil1Pin), LOW);
+  CHECK_EQ(digitalRead(coil2Pin), HIGH);
+  runUpdates(relay, 60);
+  CHECK_EQ(digitalRead(coil2Pin), LOW);
+  CHECK_EQ(relay.state, relayClass::POS2);
+}
+
+
+TEST(expiredHoldTimeIsHandledBeforeNewCommand) {
+  relayClass relay;
+  relay.init(coil1Pin, coil2Pin, 3);
+  relay.activate(relayClass::POS1);
+  hostAdvance(100);                   // update() is not called in between
+  relay.activate(relayClass::POS2);
+  CHECK_EQ(digitalRead(coil1Pin), LOW);
+  CHECK_EQ(digitalRead(coil2Pin), HIGH);
+}
+
+
+TEST(expiredHoldTimeReleasesTheScheduler) {
+  DccCoilScheduler scheduler;
+  scheduler.attach(1);
+  relayClass relay;
+  relay.init(coil1Pin, coil2Pin, 3);
+  relay.useScheduler(&scheduler);
+  relay.activate(relayClass::POS1);
+  scheduler.update();
+  CHECK_EQ(digitalRead(coil1Pin), HIGH);
+  CHECK_EQ(scheduler.active(), 1);
+  hostAdvance(100);                   // relay.update() is not called in between
+  relay.activate(relayClass::POS2);
+  CHECK_EQ(digitalRead(coil1Pin), LOW);
+  scheduler.update();
+  CHECK_EQ(digitalRead(coil2Pin), HIGH);
+  CHECK_EQ(scheduler.active(), 1);
+  runUpdates(relay, 60);
+  CHECK_EQ(scheduler.active(), 0);
+}
+
+
+TEST(restoredMonoStableRelayDoesNotReleaseTheScheduler) {
+  DccCoilScheduler scheduler;
+  scheduler.attach(1);
+  DccStateStore store;
+  store.attach(100, 64);
+  store.set(0, relayClass::POS2);
+  relayClass mono;
+  mono.init(coil1Pin, coil1Pin, 3, &store, 0);  // Energised by init(), without a grant
+  mono.useScheduler(&scheduler);
+  CHECK_EQ(digitalRead(coil1Pin), HIGH);
+  relayClass other;
+  other.init(coil2Pin, coil2Pin + 1, 3);
+  other.useScheduler(&scheduler);
+  other.activate(relayClass::POS1);
+  CHECK_EQ(scheduler.active(), 1);
+  runUpdates(mono, 100);              // The pull-in phase of the mono-stable relay ends
+  CHECK_EQ(scheduler.active(), 1);    // The coil of the other relay is still active
+  CHECK_EQ(digitalRead(coil1Pin), HIGH);
+}
+
+
+TEST(pwmHold) {
+  relayClass relay;
+  relay.init(coil1Pin, coil2Pin, 3);
+  relay.setPwmHold(100);
+  relay.activate(relayClass::POS2);
+  runUpdates(relay, 60);
+  CHECK_EQ(hostAnalogWrite(coil2Pin), 100);
+  relay.activate(relayClass::POS1);
+  CHECK_EQ(digitalRead(coil2Pin), LOW);
+  CHECK_EQ(hostAnalogWrite(coil2Pin), -1);
+}
+
+
+TEST(bankWritesBothPorts) {
+  DccRelayBank bank;
+  bank.attach(bankPin1, bankPin9);
+  CHECK_EQ(*portModeRegister(digitalPinToPort(bankPin1)), 0xFF);
+  bank.on(0);
+  bank.on(15);
+  CHECK_EQ(*portOutputRegister(digitalPinToPort(bankPin1)), 0x01);
+  CHECK_EQ(*portOutputRegister(digitalPinToPort(bankPin9)), 0x80);
+  bank.set(0x0100);
+  CHECK_EQ(bank.state(), 0x0100);
+  CHECK_EQ(*portOutputRegister(digitalPinToPort(bankPin1)), 0x00);
+  CHECK_EQ(*portOutputRegister(digitalPinToPort(bankPin9)), 0x01);
+}
+
+
+TEST(bankActiveLow) {
+  DccRelayBank bank;
+  bank.attach(bankPin1, bankPin9, false);
+  CHECK_EQ(*portOutputRegister(digitalPinToPort(bankPin1)), 0xFF);
+  bank.on(1);
+  CHECK_EQ(*portOutputRegister(digitalPinToPort(bankPin1)), 0xFD);
+}
+
+
+TEST(bankPulse) {
+  DccRelayBank bank;
+  bank.attach(bankPin1, bankPin9);
+  bank.pulse(0x0003, 100);
+  bank.pulse(0x0004, 200);
+  hostAdvance(99);
+  bank.update();
+  CHECK_EQ(bank.state(), 0x0007);
+  hostAdvance(1);
+  bank.update();
+  CHECK_EQ(bank.state(), 0x0004);
+  hostAdvance(100);
+  bank.update();
+  CHECK_EQ(bank.state(), 0x0000);
+}
+
+
+TEST(bankLongPulseIsLimited) {
+  DccRelayBank bank;
+  bank.attach(bankPin1, bankPin9);
+  bank.pulse(0x0001, 60000);
+  hostAdvance(1000);
+  bank.update();
+  CHECK(bank.isOn(0));                // Not seen as expired
+  hostAdvance(maxRelayPulse - 1000);
+  bank.update();
+  CHECK(!bank.isOn(0));
+}
+
+
+//******************************************************************************************************
+// DccRoundRobin
+//******************************************************************************************************
+static uint16_t changeState;
+static uint16_t changeMask;
+static unsigned long changes;
+
+static void relaysChanged(uint16_t state, uint16_t changed) {
+  changeState = state;
+  changeMask = changed;
+  changes++;
+}
+
+
+static void runEngine(DccRoundRobin &engine, unsigned long ms) {
+  while (ms--) {
+    hostAdvance(1);
+    engine.update();
+  }
+}
+
+
+TEST(roundRobinMode0) {
+  DccRelayBank bank;
+  DccRoundRobin engine;
+  bank.attach(bankPin1, bankPin9);
+  changes = 0;
+  engine.attach(&bank, 0, 0, 0, relaysChanged);
+  engine.command(3, true);
+  CHECK_EQ(bank.state(), 0x0008);
+  engine.command(12, true);           // Only one relay on
+  CHECK_EQ(bank.state(), 0x1000);
+  CHECK_EQ(changeMask, 0x1008);
+  engine.command(12, false);          // Off is ignored
+  CHECK_EQ(bank.state(), 0x1000);
+  CHECK_EQ(changes, 2);
+}
+
+
+TEST(roundRobinMode1) {
+  DccRelayBank bank;
+  DccRoundRobin engine;
+  bank.attach(bankPin1, bankPin9);
+  engine.attach(&bank, 1, 0, 0);
+  engine.command(3, true);
+  engine.command(5, true);
+  CHECK_EQ(bank.state(), 0x0020);
+  engine.command(5, false);
+  CHECK_EQ(bank.state(), 0x0000);
+}
+
+
+TEST(roundRobinMode2) {
+  DccRelayBank bank;
+  DccRoundRobin engine;
+  bank.attach(bankPin1, bankPin9);
+  engine.attach(&bank, 2, 0, 0);
+  engine.command(0, true);
+  engine.command(15, true);
+  CHECK_EQ(bank.state(), 0x8001);
+  engine.command(0, false);
+  CHECK_EQ(bank.state(), 0x8000);
+  engine.command(16, true);           // Out of range
+  CHECK_EQ(bank.state(), 0x8000);
+}
+
+
+TEST(roundRobinMode3StepsEveryInterval) {
+  DccRelayBank bank;
+  DccRoundRobin engine;
+  bank.attach(bankPin1, bankPin9);
+  changes = 0;
+  engine.attach(&bank, 3, 0x0109, 2, relaysChanged);   // Relays 0, 3 and 8, every 2 seconds
+  CHECK_EQ(engine.current(), 0);
+  CHECK_EQ(bank.state(), 0x0001);
+  CHECK_EQ(changes, 1);
+  runEngine(engine, 1999);
+  CHECK_EQ(bank.state(), 0x0001);
+  runEngine(engine, 1);
+  CHECK_EQ(engine.current(), 3);
+  CHECK_EQ(bank.state(), 0x0008);
+  CHECK_EQ(changeState, 0x0008);
+  CHECK_EQ(changeMask, 0x0009);
+  runEngine(engine, 2000);
+  CHECK_EQ(bank.state(), 0x0100);
+  runEngine(engine, 2000);            // Back to the first relay
+  CHECK_EQ(bank.state(), 0x0001);
+  CHECK_EQ(changes, 4);
+  // Relays outside the round-robin behave as in mode 2; the others ignore commands
+  engine.command(5, true);
+  CHECK_EQ(bank.state(), 0x0021);
+  engine.command(3, true);
+  engine.command(0, false);
+  CHECK_EQ(bank.state(), 0x0021);
+  runEngine(engine, 2000);
+  CHECK_EQ(bank.state(), 0x0028);
+}
+
+
+TEST(roundRobinMode3WithoutInterval) {
+  DccRelayBank bank;
+  DccRoundRobin engine;
+  bank.attach(bankPin1, bankPin9);
+  engine.attach(&bank, 3, 0x0003, 0);
+  runEngine(engine, 10000);
+  CHECK_EQ(bank.state(), 0x0000);     // RInter = 0 stops the round-robin
+}
@@ -0,0 +1,59 @@
+//******************************************************************************************************
+//
+// file:      DccTimer_test.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Host tests for DccTimer.
+//
+//******************************************************************************************************
+#include "AP_DccTimer.h"
+#include "HostTest.h"
+
+
+TEST(runsForTheSetTime) {
+  DccTimer timer;
+  timer.setTime(100);
+  CHECK(timer.running());
+  hostAdvance(99);
+  CHECK(timer.running());
+  CHECK(!timer.expired());
+  CHECK_EQ(timer.getRemain(), 1);
+  hostAdvance(1);
+  CHECK(!timer.running());
+  CHECK(timer.expired());
+}
+
+
+TEST(expiredIsReportedOnce) {
+  DccTimer timer;
+  timer.setTime(10);
+  hostAdvance(20);
+  CHECK(timer.expired());
+  CHECK(!timer.expired());
+  timer.restart();
+  hostAdvance(10);
+  CHECK(timer.expired());
+}
+
+
+TEST(stopCancelsTheTimer) {
+  DccTimer timer;
+  timer.setTime(10);
+  timer.stop();
+  hostAdvance(20);
+  CHECK(!timer.running());
+  CHECK(!timer.expired());
+  CHECK_EQ(timer.getElapsed(), 10);
+}
+
+
+TEST(millisWrapAround) {
+  hostAdvance(0xFFFFFFFFUL - 5);
+  DccTimer timer;
+  timer.setTime(10);
+  hostAdvance(8);                     // millis() wrapped
+  CHECK(timer.running());
+  hostAdvance(2);
+  CHECK(timer.expired());
+}
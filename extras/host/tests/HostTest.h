@@ -0,0 +1,76 @@
+//******************************************************************************************************
+//
+// file:      HostTest.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Minimal test support for the host tests; no test framework is needed.
+//
+// Each test is a function registered with TEST(name). CHECK() and CHECK_EQ() report a failure
+// with its file and line, and the test continues. hostReset() is called before every test.
+// The program returns 1 if any check failed, which ctest reports as a failed test.
+//
+//******************************************************************************************************
+#pragma once
+#include <stdio.h>
+#include "HostShim.h"
+
+#define maxHostTests      32
+
+typedef void (*hostTestFunction_t)(void);
+
+struct hostTest_t {
+  const char *name;
+  hostTestFunction_t function;
+};
+
+static hostTest_t hostTests[maxHostTests];
+static uint8_t hostTestCount;
+static unsigned long hostFailures;
+
+
+struct hostTestRegistration {
+  hostTestRegistration(const char *name, hostTestFunction_t function) {
+    if (hostTestCount < maxHostTests) {
+      hostTests[hostTestCount].name = name;
+      hostTests[hostTestCount].function = function;
+      hostTestCount++;
+    }
+  }
+};
+
+
+#define TEST(name)                                                                  \
+  static void test_##name(void);                                                    \
+  static hostTestRegistration register_##name(#name, test_##name);                  \
+  static void test_##name(void)
+
+#define CHECK(condition)                                                            \
+  do {                                                                              \
+    if (!(condition)) {                                                             \
+      printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition);          \
+      hostFailures++;                                                               \
+    }                                                                               \
+  } while (0)
+
+#define CHECK_EQ(actual, expected)                                                  \
+  do {                                                                              \
+    long a_ = (long)(actual);                                                       \
+    long e_ = (long)(expected);                                                     \
+    if (a_ != e_) {                                                                 \
+      printf("%s:%d: CHECK_EQ(%s, %s) failed: %ld != %ld\n",                        \
+             __FILE__, __LINE__, #actual, #expected, a_, e_);                       \
+      hostFailures++;                                                               \
+    }                                                                               \
+  } while (0)
+
+
+int main(void) {
+  for (uint8_t i = 0; i < hostTestCount; i++) {
+    unsigned long before = hostFailures;
+    hostReset();
+    hostTests[i].function();
+    printf("%-40s %s\n", hostTests[i].name, (hostFailures == before) ? "ok" : "FAILED");
+  }
+  return (hostFailures == 0) ? 0 : 1;
+}
@@ -5,6 +5,15 @@
 // History:   2021/06/14 AP Version 1.0
 //            2021/12/30 AP Version 1.2
 //            2022/08/02 AP Version 1.3 Restructure of the library
+//            2026/10/18 AP Version 1.4 Subsystems can be excluded (see core_features.h)
+//            2026/10/18 AP Version 1.5 Trace events (see AP_DccTrace.h)
+//            2026/10/18 AP Version 1.6 Multiple accessory addresses (see AP_DccAddressSet.h)
+//            2026/10/18 AP Version 1.7 Command dispatch per output (see AP_DccDispatcher.h)
+//            2026/10/18 AP Version 1.8 Change driven RS-Bus feedback (see AP_DccFeedback.h)
+//            2026/10/18 AP Version 1.9 Signal quality statistics (see AP_DccSignalQuality.h)
+//            2026/10/18 AP Version 1.10 Staged start-up, with ready time and first answer time
+//            2026/10/18 AP Version 1.11 Host builds: reboot() calls hostReboot() (see extras/host)
+//            2026/10/18 AP Version 1.12 readCv(): the live value of a CV, as used by PoM feedback
 // Purpose:   Header file for accessory decoders that use the RS-Bus for feedback.
 //            PoM feedback messages use instead of RailCom the RS-Bus with address 128.
 //
@@ -29,10 +38,17 @@
 #include <Arduino.h>                  // For general definitions
 #include <AP_DCC_library.h>           // Interface to DCC input and DCC Ack pin
 #include <RSbus.h>                    // Interface to the Lenz RS-bus
+#include "core_features.h"            // Which subsystems of the core are included
 #include "CvValues/CvValues.h"        // To define and access cvValue
 #include "AP_DccButton.h"             // For the onboard Button
+#include "AP_DccGesture.h"            // For clicks and holds on the onboard Button
 #include "AP_DccLED.h"                // For the onboard LED
 #include "AP_DccTimer.h"              // Allows timers to be used
+#include "AP_DccTrace.h"              // Binary trace buffer for diagnostics
+#include "AP_DccAddressSet.h"         // The accessory addresses of the decoder
+#include "AP_DccDispatcher.h"         // Calls the handlers per output for received commands
+#include "AP_DccFeedback.h"           // Sends changes of the feedback state via the RS-Bus
+#include "AP_DccSignalQuality.h"      // Statistics of DCC and RS-Bus errors
 #include "boards.h"                   // Pins and USART being used for the various boards
 
 
@@ -42,11 +58,21 @@ class Processor {
     void reboot(void);                            // Restarts the decoder, using the latest EEPROM CV values
 };
 
+#if !defined(__AVR__)
+// A host build can not restart the program. reboot() then calls hostReboot() and returns.
+// hostReboot() is provided by the Arduino API shim (extras/host/shim).
+void hostReboot(void);
+#endif
+
 
 class CvProgramming {
   public:
     void initPoM(void);                           // Set the Loco address for PoM messages and the RS-Pom address
     void processMessage(Dcc::CmdType_t cmdType);  // Called if we have a PoM or SM message
+    // Writes a CV, or acts on special CVs (CV7, CV8, CV23, CV25). SM: send a DCC-Ack
+    void writeCv(unsigned int number, uint8_t value, bool SM = false);
+    // Reads a CV. Returns the live value for CV23, CV26, CV31, CV32 and the diagnostic CVs
+    uint8_t readCv(unsigned int number);
 
   private:
     void pom_feedback(void);                      // Sends a PoM feedback message
@@ -59,6 +85,16 @@ class CommonDecHwFunctions {
     void init(void);                              // Should be called from init() in the main sketch.
     void update(void);                            // Should be called from main as often as possible.
     unsigned long TLast;                          // Some elements of update() are called every 20ms
+
+    // Start-up metrics, in ms since the processor started (millis())
+    unsigned long attachTime;                     // DCC and RS-Bus interfaces attached
+    unsigned long readyTime;                      // Start-up completed (EEPROM filled)
+    unsigned long answerTime;                     // First answer to a feedback request queued (0: none yet)
+    bool ready(void) {return _ready;}
+    void feedbackAnswered(void);                  // Called after send8bits() answered a feedback request
+
+  private:
+    bool _ready;
 };
 
 
@@ -84,5 +120,17 @@ extern CvAccess cvCmd;                       // Instantiated in AP_DCC_library.c
 
 // The following objects provide access to the onboard LED, as well as the
 // onboard programming button
+#if DCC_CORE_LED
 extern DccLed onBoardLed;                    // Instantiated in AP_DCC_Decoder_Core.cpp
+#endif
 extern CommonDecHwFunctions decoderHardware; // Instantiated in AP_DCC_Decoder_Core.cpp
+extern DccAddressSet decoderAddresses;       // Instantiated in AP_DCC_Decoder_Core.cpp
+#if DCC_CORE_DISPATCH
+extern DccDispatcher commandDispatcher;      // Instantiated in AP_DCC_Decoder_Core.cpp
+#endif
+#if DCC_CORE_FEEDBACK
+extern DccFeedback rsFeedback;               // Instantiated in AP_DCC_Decoder_Core.cpp
+#endif
+#if DCC_CORE_QUALITY
+extern DccSignalQuality signalQuality;       // Instantiated in AP_DCC_Decoder_Core.cpp
+#endif
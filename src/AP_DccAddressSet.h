@@ -0,0 +1,60 @@
+//*****************************************************************************************************
+//
+// File:      AP_DccAddressSet.h
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   The set of accessory addresses a decoder listens to
+//
+// The AP_DCC_library compares accessory commands with a single address, and reports commands for
+// that address as MyAccessoryCmd. Decoders with many outputs, such as a decoder with 16 relays,
+// need multiple addresses, and therefore had to inspect every AnyAccessoryCmd themselves.
+// A DccAddressSet holds all addresses of the decoder, as a window of 64 addresses that starts at
+// the address stored in CV1/CV9 (the base address). Within that window, the decoder may use:
+// - a range: the first `count` addresses (setRange), or
+// - a list: scattered addresses, for example configured via CVs (add, addFromCvs).
+// Each address is a bit in a bitmap, so match() needs a subtraction, a compare and a bit test.
+//
+// match() also numbers the outputs of the decoder. The n-th address of the set (n = 0, 1, ...)
+// gives:
+// - decoder addressing: index = n * 4 + turnout - 1 (so 0..3 for the first address)
+// - output addressing:  index = n
+//
+// The core contains a DccAddressSet object, decoderAddresses, which is initialised by
+// decoderHardware.init() with the base address and the address mode (CV29). By default the set
+// contains the base address only.
+//
+//*****************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define addressWindow   64          // Number of addresses (starting at the base) that can be used
+
+
+class DccAddressSet {
+  public:
+    uint8_t index;                                // Output index of the last match()
+
+    // base: first address of the window (65535: address not set, nothing matches).
+    // outputAddressing: compare output addresses instead of decoder addresses
+    void init(unsigned int base, bool outputAddressing);
+
+    void setRange(uint8_t count);                 // Addresses base .. base + count - 1
+    void add(uint8_t offset);                     // Adds address base + offset (offset < 64)
+    // Adds the addresses base + value of CV firstCv .. firstCv + count - 1.
+    // CVs with values of 64 or higher are skipped, so 255 may be used for "no address".
+    void addFromCvs(uint8_t firstCv, uint8_t count);
+    void clear(void);                             // Removes all addresses
+
+    // Returns true if the last command received by dcc.input() is an accessory command for one
+    // of our addresses. If so, index holds the output index.
+    bool match(void);
+
+    unsigned int base(void) {return _base;}
+
+  private:
+    unsigned int _base;
+    bool _outputAddressing;
+    uint8_t _range;                               // Set is a range of _range addresses (0: a list)
+    uint8_t _bitmap[addressWindow / 8];
+};
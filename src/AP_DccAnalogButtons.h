@@ -0,0 +1,98 @@
+//*******************************************************************************************
+//
+// file:      AP_DccAnalogButtons.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0   Initial version
+//            2026-10-18 V1.1   ADC multiplexer saved and restored, converting()
+//
+// purpose:   Reads several buttons that are connected via a resistor ladder to a single
+//            analog (ADC) input pin.
+//
+// Small boards, such as the Nano 4808 or the ATMega16 boards, have few spare digital pins.
+// By connecting several buttons via a resistor ladder to a single ADC pin, a front panel with
+// multiple buttons can be made that requires a single pin only. Each button gives a different
+// voltage, and thus a different ADC value:
+//
+//    Vcc ---[ R pullup ]---+--------+--------+--------+----> ADC pin
+//                          |        |        |        |
+//                        [B0]     [R1]     [R1]     [R1]
+//                          |        |        |        |
+//                         GND     [B1]     [B2]     [B3]
+//                                   |        |        |
+//                                  GND      GND      GND  (and so on)
+//
+// The buttons are identified by a (windowed) classification table, that contains per button
+// the upper bound of its (8 bit) ADC value. The table should be in ascending order; values
+// above the last entry mean that no button is pressed. As with every resistor ladder, only
+// one button can be pressed at a time.
+//
+// Standard analogRead() waits some 100us till the conversion has finished. Instead, this class
+// starts a conversion and returns immediately; the result is collected by the next call
+// of read(), once the conversion is ready. Samples are taken every 5ms. A new state is
+// accepted after `dbSamples` consecutive samples with the same classification.
+//
+// The ADC is configured by a single call to analogRead() within attach(). Before each conversion
+// the multiplexer is set to our pin, and the multiplexer settings of the sketch (ADMUX, as well as
+// MUX5 in ADCSRB on the ATMega2560, or ADC0.MUXPOS) are saved; once the conversion is collected,
+// these settings are restored. The main sketch may therefore still use analogRead() for other
+// pins, but NOT between the start of a conversion and its collection: analogRead() would then
+// wait for our conversion, and return the value of our pin. converting() tells if a conversion
+// is running; if it returns false, analogRead() can be called safely.
+//
+// The class offers the same isPressed / wasPressed / pressedFor API as DccButton, but with a
+// button number as parameter.
+//
+//*******************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define noAnalogButton  0xFF
+
+
+class DccAnalogButtons {
+
+public:
+  // pin:       the ADC pin the resistor ladder is connected to
+  // limits:    per button the upper bound of the ADC value (0..255, ADC value / 4).
+  //            The table is not copied, so should remain valid (global or static).
+  // count:     number of buttons (entries in the limits table)
+  // dbSamples: number of equal samples (5ms apart) before a new state is accepted
+  void attach(uint8_t pin, const uint8_t *limits, uint8_t count, uint8_t dbSamples=4);
+
+  // Collects the result of the ADC conversion (if ready) and starts a new conversion
+  // (if 5ms have passed). Should be called frequently from the main loop.
+  void read();
+
+  // These functions refer to the last call of read(), and do not cause the ADC to be read.
+  bool isPressed(uint8_t button);
+  bool isReleased(uint8_t button);
+  bool wasPressed(uint8_t button);
+  bool wasReleased(uint8_t button);
+  bool pressedFor(uint8_t button, unsigned long ms);
+  uint8_t pressedButton() {return _current;}         // noAnalogButton if none
+  uint8_t lastValue() {return _value;}               // last (8 bit) ADC value, for calibration
+  bool converting() {return _converting;}            // if true, analogRead() should not be called
+
+private:
+  const uint8_t *_limits;
+  uint8_t _pin;
+  uint8_t _count;
+  uint8_t _dbSamples;
+  uint8_t _mux;                    // ADC multiplexer setting of our pin
+  uint8_t _muxB;                   // ADCSRB (MUX5) setting of our pin, ATMega2560 only
+  uint8_t _savedMux;               // multiplexer settings of the sketch, restored after a conversion
+  uint8_t _savedMuxB;
+  bool _converting;                // a conversion has been started
+  uint8_t _lastSample;             // lower byte of millis() at the last sample
+  uint8_t _value;                  // last ADC value (8 bit)
+  uint8_t _candidate;              // classification of the last samples
+  uint8_t _equalSamples;           // number of consecutive samples with the same classification
+  uint8_t _current;                // debounced button
+  uint8_t _previous;               // debounced button before the last change
+  bool _changed;                   // state changed during the last call of read()
+  unsigned long _lastChange;       // time of the last state change (ms)
+
+  void startConversion();
+  bool conversionReady();
+  uint8_t classify(uint8_t value);
+};
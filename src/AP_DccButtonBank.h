@@ -0,0 +1,88 @@
+//*******************************************************************************************
+//
+// file:      AP_DccButtonBank.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0   Initial version
+//
+// purpose:   Reads and debounces a bank of buttons that are connected to one or more
+//            (8 bit) input ports. All buttons of a port are read with a single port read,
+//            and are debounced in parallel using vertical counters.
+//
+// Whereas a DccButton object needs some 20 bytes of RAM per button and calls millis() at
+// every read(), a DccButtonBank needs per port (thus per 8 buttons) 15 bytes, plus a single
+// byte per attached button to map the button number onto its port and bit.
+// This makes the class suitable for front panels with many buttons, such as the
+// TMC 24 channel IO decoder.
+//
+// Debouncing uses a 2-bit vertical counter per button: a button changes state after four
+// consecutive samples (taken every `scanTime` milliseconds) that differ from the current
+// debounced state. Long presses are detected using a second, 4-bit vertical counter per
+// button, which counts in steps of `longTime / 15` milliseconds.
+//
+//*******************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define maxBankPorts    3         // Maximum number of 8 bit input ports (thus 24 buttons)
+#define maxBankButtons  (maxBankPorts * 8)
+
+
+class DccButtonBank {
+
+public:
+  // attach(pin, puEnable, invert) adds a button to the bank. The first button attached
+  // becomes button 0, the next button 1, etc. Returns false if the button can not be added,
+  // since the bank is full or the button is on a port that would exceed maxBankPorts.
+  // Similar to DccButton, the internal pullup is enabled by default and a low level
+  // is interpreted as pressed.
+  bool attach(uint8_t pin, bool puEnable=true, bool invert=true);
+
+  // Sets the time between two port samples (default: 5ms, giving 20ms debounce time)
+  // and the time after which a button that is kept pressed becomes "long pressed"
+  // (default 1000ms, maximum 15 * 255 ms).
+  void setTimes(uint8_t scanTime, uint16_t longTime);
+
+  // Samples all ports, if scanTime has passed since the previous sample.
+  // Should be called frequently from the main loop.
+  void read();
+
+  // Per button functions. Similar to DccButton, these functions refer to the last call
+  // of read() and do not cause the buttons to be read.
+  bool isPressed(uint8_t button);
+  bool isReleased(uint8_t button);
+  bool wasPressed(uint8_t button);       // Pressed since the previous call to read()
+  bool wasReleased(uint8_t button);      // Released since the previous call to read()
+  bool isLongPressed(uint8_t button);    // Pressed for at least longTime
+  bool wasLongPressed(uint8_t button);   // Became long pressed since the previous read()
+
+  // Per port functions. Bit n of the returned mask refers to bit n of the input port.
+  // portIndex is 0 for the port of the first button attached, 1 for the next port, etc.
+  uint8_t pressedMask(uint8_t portIndex);      // Current debounced state
+  uint8_t pressedEdges(uint8_t portIndex);     // Buttons that got pressed
+  uint8_t releasedEdges(uint8_t portIndex);    // Buttons that got released
+  uint8_t longEdges(uint8_t portIndex);        // Buttons that became long pressed
+
+  uint8_t buttons = 0;                   // Number of buttons attached
+  uint8_t ports = 0;                     // Number of ports in use
+
+private:
+  struct bankPort_t {
+    volatile uint8_t *portRegister;      // Input register of this port
+    uint8_t mask;                        // Bits of this port that have a button attached
+    uint8_t invert;                      // Bits that are pressed if the input is low
+    uint8_t state;                       // Debounced state, 1 = pressed
+    uint8_t cnt0, cnt1;                  // 2 bit vertical debounce counter
+    uint8_t hold0, hold1, hold2, hold3;  // 4 bit vertical long press counter
+    uint8_t pressed;                     // Edges detected during the last sample
+    uint8_t released;
+    uint8_t longPressed;
+  };
+  bankPort_t bank[maxBankPorts];
+  uint8_t map[maxBankButtons];           // Per button: port index (high nibble) and bit (low)
+  uint8_t portNumber[maxBankPorts];      // Arduino port number (PA=1, PB=2, ...)
+  uint8_t scanTime = 5;                  // Time between samples (ms)
+  uint8_t holdTick = 1000 / 15;          // Time between long press counter steps (ms)
+  uint8_t lastScan;                      // Lower byte of millis() at the last sample
+  uint8_t lastHold;                      // Lower byte of millis() at the last hold step
+  bool edges = false;                    // Are there edges that need to be cleared?
+};
@@ -0,0 +1,65 @@
+//******************************************************************************************************
+//
+// file:      AP_DccCoilScheduler.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Limits the number of relay / switch coils that are active at the same time.
+//
+// Each relayClass object activates its coil as soon as activate() is called. If a route sets ten
+// turnouts, all ten coils are energised at once, which may cause the power supply or the
+// Capacitive Discharge Unit (CDU) to brown out. Relays that are coupled to a DccCoilScheduler
+// (via relay.useScheduler()) instead request permission, and activate their coil once the
+// scheduler grants it. The scheduler enforces:
+// - maxActive: the maximum number of coils that may be active simultaneously
+// - recharge:  the minimum time (in ms) between switching off a coil and activating the next one
+//              (for example to allow a CDU to recharge)
+// Waiting requests are granted in FIFO order (first come, first served), or in priority order
+// (highest priority first; FIFO for equal priorities).
+//
+// How long a coil stays active is still determined by the relay itself (holdTime, which is
+// normally taken from the T_on_F1..F4 CVs), so each output keeps its own activation time.
+//
+// Relays stay in the queue till they are granted, so the queue (maxCoilRequests) should be at
+// least as large as the number of relays that use the scheduler.
+//
+//******************************************************************************************************
+#pragma once
+#include <Arduino.h>
+#include "AP_DccRelay.h"
+
+#define maxCoilRequests   16        // Maximum number of relays waiting for permission
+
+
+class DccCoilScheduler {
+  public:
+    typedef enum {fifo, priority} order_t;
+
+    // maxActive: number of coils that may be active simultaneously (minimum 1)
+    // recharge:  minimum time in ms between switching off a coil and activating the next one
+    // order:     fifo or priority
+    void attach(uint8_t maxActive = 1, uint16_t recharge = 0, order_t order = fifo);
+
+    // Should be called as frequent as possible from main. Grants waiting requests.
+    void update();
+
+    uint8_t active() {return _active;}      // Number of coils currently active
+    uint8_t waiting() {return _waiting;}    // Number of relays waiting for permission
+
+  private:
+    friend class relayClass;
+    bool request(relayClass *relay, uint8_t prio);  // Returns false if the queue is full
+    void cancel(relayClass *relay);
+    void release();                                 // A coil has been switched off
+
+    relayClass *_queue[maxCoilRequests];            // Waiting relays, in order of arrival
+    uint8_t _prio[maxCoilRequests];
+    uint8_t _waiting = 0;
+    uint8_t _active = 0;
+    uint8_t _maxActive = 1;
+    uint16_t _recharge = 0;
+    order_t _order = fifo;
+    unsigned long _lastRelease = 0;
+
+    void remove(uint8_t index);
+};
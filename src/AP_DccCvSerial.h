@@ -0,0 +1,75 @@
+//*****************************************************************************************************
+//
+// File:      AP_DccCvSerial.h
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//            2026/10/18 AP Version 1.1 CVs are read with cvProgramming.readCv(), as for PoM feedback
+//
+// Purpose:   Reads and writes blocks of CVs via a serial port
+//
+// Via PoM or SM, CVs are read and written one at a time, and each CV takes multiple DCC packets.
+// Configuring a series of decoders this way is slow. DccCvSerial allows a PC to read and write
+// blocks of up to cvBlockSize CVs via a serial port (USB), using a framed binary protocol with a
+// CRC. extras/cvtool.py uses this protocol to save the CVs of a decoder into a profile, and to
+// write a profile to a decoder and verify the result.
+//
+// Frames (both directions):
+//
+//   +------+-----+---------+---------+-----+------------------+---------+---------+
+//   | 0x7E | cmd | CV low  | CV high | len | data (len bytes) | CRC low | CRC high|
+//   +------+-----+---------+---------+-----+------------------+---------+---------+
+//
+// The CRC is the CRC-16/CCITT (polynomial 0x1021, start value 0xFFFF) over cmd up to the data.
+// The CV number is the first CV of the block; len is the number of CVs.
+// Commands from the PC, with the answer of the decoder:
+// - 'R' (read block):  no data.     Answer: 'r' with the len values of the CVs.
+// - 'W' (write block): len values.  Answer: 'w' without data, once all CVs are written.
+// - Errors:                         Answer: 'e' with one data byte: the error code.
+//
+// update() handles all bytes that have been received, but never waits: frames are assembled over
+// multiple calls, CVs are written one per call, and an answer is only sent once it fits in the
+// free space of the UART transmit buffer. A partially received frame is discarded after 100ms.
+//
+// CVs are written via cvProgramming.writeCv(), so the same rules apply as for PoM and SM:
+// CV7 can not be written, CV8 = 0x0D restores the defaults and CV25 restarts the decoder. To allow
+// a profile that was read from a decoder to be written back, CVs that already have the requested
+// value are skipped; writing the stored 0x0D to CV8 therefore does not restore the defaults.
+// CVs are read via cvProgramming.readCv(), so a read block returns the same values as PoM
+// feedback, including the live values of CV23, CV26, CV31, CV32 and the diagnostic CVs.
+//
+//*****************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define cvBlockSize     32          // Maximum number of CVs per frame
+
+// Error codes
+#define cvErrorCrc      1           // CRC of the received frame is incorrect
+#define cvErrorRange    2           // CV number 0, or beyond the EEPROM
+#define cvErrorLength   3           // len is 0 or larger than cvBlockSize
+#define cvErrorCommand  4           // Unknown command
+
+
+class DccCvSerial {
+  public:
+    // port: the serial port, which should already have been started with begin()
+    void attach(Stream &port);
+
+    // Should be called as often as possible from main.
+    void update(void);
+
+  private:
+    typedef enum {waitSync, receiving, writing, answering} state_t;
+    Stream *_port = nullptr;
+    state_t _state;
+    uint8_t _frame[cvBlockSize + 7];              // Frame being received or sent
+    uint8_t _received;                            // Number of bytes received (excluding sync)
+    uint8_t _next;                                // Next CV to write (index in the block)
+    unsigned long _lastByte;                      // millis() when the last byte was received
+
+    uint8_t dataLength(void);                     // Number of data bytes of the received frame
+    void process(void);
+    void answer(uint8_t cmd, uint8_t len);        // Prepares the answer in _frame
+    void error(uint8_t code);
+    static uint16_t crc16(const uint8_t *data, uint8_t length);
+};
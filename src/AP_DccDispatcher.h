@@ -0,0 +1,75 @@
+//*****************************************************************************************************
+//
+// File:      AP_DccDispatcher.h
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   Table driven dispatch of accessory commands to handlers per output
+//
+// Without dispatcher, every sketch repeats the same switch on dcc.cmdType in loop(), and branches
+// further on accCmd.outputAddress, accCmd.position and accCmd.activate. With a dispatcher, the
+// sketch provides a table with per output (see DccAddressSet for the numbering of outputs) a
+// handler for basic and a handler for extended accessory commands. decoderHardware.update() then
+// takes the commands from dcc.input(), and calls the handler of the output directly:
+//
+//   void turnout(uint8_t index, uint8_t position, bool activate) { ... }
+//   void signal(uint8_t index, uint8_t aspect, bool activate) { ... }
+//
+//   DccOutputSlot outputs[4] = {
+//     {turnout, 0, 0},
+//     {turnout, 0, 0},
+//     {0, signal, 0},
+//     {0, signal, 0}
+//   };
+//   commandDispatcher.attach(outputs, 4);
+//
+// For basic commands the handler receives accCmd.position and accCmd.activate; for extended
+// commands it receives the aspect (accCmd.position) and true. The sketch should no longer call
+// dcc.input() itself once the dispatcher is attached. SM and PoM commands are passed to
+// cvProgramming; all other commands may be handled by a handler set with onOther().
+//
+// Each slot counts the commands for its output (also if it has no handler), which may be used
+// for diagnostics. The counters wrap around after 65535 commands.
+//
+//*****************************************************************************************************
+#pragma once
+#include <Arduino.h>
+#include <AP_DCC_library.h>
+
+#define dispatchBurst   4           // Maximum number of commands taken per call of update()
+
+typedef void (*accHandler_t)(uint8_t index, uint8_t position, bool activate);
+typedef void (*otherHandler_t)(Dcc::CmdType_t cmdType);
+
+struct DccOutputSlot {
+  accHandler_t basic;               // Handler for basic accessory commands (0: ignore)
+  accHandler_t extended;            // Handler for extended accessory commands (0: ignore)
+  uint16_t commands;                // Number of commands received for this output
+};
+
+
+class DccDispatcher {
+  public:
+    // Provides the table with count outputs. The table is not copied, and its counters are cleared.
+    void attach(DccOutputSlot *slots, uint8_t count);
+    void detach(void) {_count = 0;}               // The sketch calls dcc.input() itself again
+    bool attached(void) {return (_count > 0);}
+
+    // Sets the handlers of one output, as alternative to a statically initialised table.
+    void set(uint8_t index, accHandler_t basic, accHandler_t extended = 0);
+    void onOther(otherHandler_t handler) {_other = handler;}
+
+    uint16_t commands(uint8_t index);             // Number of commands for this output
+    void clearCounters(void);
+
+    // Takes up to dispatchBurst commands from dcc.input() and calls their handlers.
+    // Called by decoderHardware.update(); should not be called by the main sketch.
+    void update(void);
+
+  private:
+    DccOutputSlot *_slots;
+    uint8_t _count;
+    otherHandler_t _other;
+
+    void dispatch(void);
+};
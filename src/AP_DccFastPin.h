@@ -0,0 +1,91 @@
+//******************************************************************************************************
+//
+// file:      AP_DccFastPin.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Fast output pin. The port register and bit mask of the pin are looked up once, in
+//            attach(). high(), low() and read() then access the port directly, instead of
+//            performing the table lookups of digitalWrite() / digitalRead() on every call.
+//
+// MegaCoreX and DxCore offer digitalWriteFast(), which compiles into a single instruction, but
+// requires the pin number to be a compile time constant. The classic Arduino cores store the
+// pin to port mapping in PROGMEM tables, which can not be read at compile time. A generic library
+// therefore can not resolve ports at compile time; the next best thing is to resolve them once.
+//
+// - MegaAVR (4808, 4809) and DA/DB processors: the OUTSET and OUTCLR registers are used, so a
+//   single store changes the pin, without affecting other pins of the same port.
+// - Traditional ATMega processors (16, 328, 2560): the port is changed with a read-modify-write,
+//   with interrupts disabled, so that ISRs that change other pins of the same port are not
+//   disturbed.
+// - Other architectures (Arduino API shims): digitalWrite() / digitalRead() are used.
+//
+// Unlike digitalWrite(), high() and low() do not switch off a PWM signal (analogWrite) on the pin.
+// Objects that use analogWrite() on the same pin should use digitalWrite() to end the PWM signal.
+//
+// The functions are defined in this header file, so that the compiler can inline them.
+//
+//******************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+
+class DccFastPin {
+  public:
+    void attach(uint8_t pin) {        // makes the pin an output
+      pinMode(pin, OUTPUT);
+      #if defined(__AVR__)
+        _out = portOutputRegister(digitalPinToPort(pin));
+        _mask = digitalPinToBitMask(pin);
+      #else
+        _pin = pin;
+      #endif
+    }
+
+    void high(void) {
+      #if defined(__AVR_XMEGA__)
+        _out[1] = _mask;              // PORTx.OUTSET follows PORTx.OUT
+      #elif defined(__AVR__)
+        uint8_t oldSREG = SREG;
+        noInterrupts();
+        *_out |= _mask;
+        SREG = oldSREG;
+      #else
+        digitalWrite(_pin, HIGH);
+      #endif
+    }
+
+    void low(void) {
+      #if defined(__AVR_XMEGA__)
+        _out[2] = _mask;              // PORTx.OUTCLR
+      #elif defined(__AVR__)
+        uint8_t oldSREG = SREG;
+        noInterrupts();
+        *_out &= ~_mask;
+        SREG = oldSREG;
+      #else
+        digitalWrite(_pin, LOW);
+      #endif
+    }
+
+    void write(bool value) {
+      if (value) high();
+      else low();
+    }
+
+    bool read(void) {                 // the level the pin is set to (not the input level)
+      #if defined(__AVR__)
+        return (*_out & _mask);
+      #else
+        return (digitalRead(_pin) == HIGH);
+      #endif
+    }
+
+  private:
+    #if defined(__AVR__)
+      volatile uint8_t *_out;         // Output register of the port
+      uint8_t _mask;                  // Bit of the pin within the port
+    #else
+      uint8_t _pin;
+    #endif
+};
@@ -0,0 +1,84 @@
+//*****************************************************************************************************
+//
+// File:      AP_DccFeedback.h
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//            2026/10/18 AP Version 1.1 Feedback requests are answered on every update() call
+//
+// Purpose:   Change driven RS-Bus feedback for one or more consecutive RS-Bus addresses
+//
+// Without feedback manager, each sketch keeps its own feedback state per RS-Bus address, and calls
+// send8bits() for every change. If outputs change rapidly (occupancy chatter, a route being set),
+// the RS-Bus FIFOs fill with updates that are outdated before they are sent, and PoM answers on
+// RS-Bus address 128 have to wait behind them.
+// A DccFeedback object instead keeps per RS-Bus address the current state, as set by the sketch,
+// and the state that was sent last. Once every 20ms (tick(), from decoderHardware.update()) it
+// decides what to send:
+// - only changes are sent: if an output changes and changes back before it could be sent,
+//   nothing is sent.
+// - transmissions per address are at least `window` ms apart. Changes within the window are
+//   coalesced into a single transmission of the latest state. The first change after a quiet
+//   period is sent without delay.
+// - after a transmission, the same state is repeated RSFEC (CV20, 0..2) times, each time after
+//   the window. A new change restarts the repetitions.
+// - after a PoM answer has been queued on address 128, new transmissions are postponed for
+//   pomPriority ticks, so the answer is not delayed by bulk feedback.
+// - if the master station requests feedback (feedbackRequested), the current state is sent. This,
+//   and the transfer of the slot FIFOs to the RS-Bus (checkConnection()), is done on every call of
+//   decoderHardware.update() (update()), and does not wait for the tick.
+//
+// The sketch provides the memory for the RS-Bus addresses. Each slot contains the RSbusConnection
+// of that address, so the sketch does not need its own RSbusConnection objects:
+//
+//   DccFeedbackSlot feedbackSlots[2];
+//   rsFeedback.attach(feedbackSlots, 2, cvValues.read(myRSAddr));
+//   rsFeedback.setBit(11, true);               // Output 11: RS-Bus address + 1, bit 3
+//
+//*****************************************************************************************************
+#pragma once
+#include <Arduino.h>
+#include <RSbus.h>
+
+#define feedbackTick    20          // update() is called every 20ms
+#define pomPriority     3           // Ticks bulk feedback waits after a PoM answer
+
+struct DccFeedbackSlot {
+  RSbusConnection connection;       // The RS-Bus address of this slot
+  uint8_t current;                  // State as set by the sketch
+  uint8_t sent;                     // State sent last
+  uint8_t wait;                     // Ticks before the next transmission is allowed
+  uint8_t repeats;                  // Number of RSFEC repetitions still to be sent
+};
+
+
+class DccFeedback {
+  public:
+    // Provides count slots, for the RS-Bus addresses firstAddress .. firstAddress + count - 1,
+    // and sets the minimum time (ms) between transmissions to the same address.
+    // The number of repetitions is read from RSFEC (CV20).
+    void attach(DccFeedbackSlot *slots, uint8_t count, uint8_t firstAddress, uint8_t window = 60);
+
+    void set(uint8_t slot, uint8_t value);        // All 8 bits of a slot (RS-Bus address)
+    void setBit(uint8_t output, bool value);      // output = slot * 8 + bit
+    uint8_t value(uint8_t slot);                  // Current state of a slot
+
+    // Postpones new transmissions, so a PoM answer can be sent first. Called by cvProgramming.
+    void defer(void) {_deferred = pomPriority;}
+
+    // Answers feedback requests of the master station, and checks the RS-Bus connection of each
+    // slot. Called by decoderHardware.update() on every call; should not be called by the main sketch.
+    void update(void);
+
+    // Sends the changes, and the RSFEC repetitions. Called every 20ms by decoderHardware.update();
+    // should not be called by the main sketch.
+    void tick(void);
+
+  private:
+    DccFeedbackSlot *_slots;
+    uint8_t _count;
+    uint8_t _window;                              // In ticks
+    uint8_t _fec;                                 // Number of repetitions (RSFEC)
+    uint8_t _deferred;                            // Ticks till bulk feedback may be sent again
+
+    void send(DccFeedbackSlot &slot);
+};
@@ -0,0 +1,70 @@
+//*******************************************************************************************
+//
+// file:      AP_DccGesture.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0   Initial version
+//
+// purpose:   Recognises gestures on a (debounced) DccButton: single, double and triple
+//            clicks, as well as up to three hold levels.
+//
+// The recogniser is a small state machine that is called from the main loop (or from another
+// update() function). It never waits: each call to update() reads the button once and returns
+// immediately, possibly with a gesture.
+//
+//                 +-----------+  pressed  +-----------+  hold1   +-----------+
+//   attach() ---> | waitFree  |           |  pressed  | -------> |  holding  | --> hold2, hold3
+//                 +-----------+           +-----------+          +-----------+
+//                       | released          ^       | released         | released
+//                       v                   |       v                  v
+//                 +-----------+  pressed    |  +-----------+        holdEnd
+//                 |   idle    | ------------+  |  released | --> click1, click2, click3
+//                 +-----------+                +-----------+     (after clickGap, or
+//                                                                 directly after click 3)
+//
+// A click is a press that is released before the first hold level is reached. Clicks that
+// follow each other within `clickGap` milliseconds are counted together. Hold gestures are
+// reported once the button is kept pressed for the given time; holdEnd is reported once
+// the button is released again, and holdLevel() tells which level was reached.
+//
+// Since a single click can only be reported once clickGap has passed without a new press,
+// the single click is reported with a delay of clickGap milliseconds.
+//
+//*******************************************************************************************
+#pragma once
+#include <Arduino.h>
+#include "AP_DccButton.h"
+
+
+class DccGesture {
+
+public:
+  typedef enum {none, click1, click2, click3, hold1, hold2, hold3, holdEnd} gesture_t;
+
+  // Attaches the recogniser to an (already attached) button. The button is ignored until it
+  // has been released, to avoid that a button that is pressed at startup or a pin that
+  // settles after power-on is regarded as a gesture.
+  void attach(DccButton *button);
+
+  // clickGap: maximum time between the release and the next press of a multiple click.
+  // holdTime1..3: time the button should be pressed for each hold level. 0 = not used.
+  void setTimes(uint16_t clickGap, uint16_t holdTime1, uint16_t holdTime2=0, uint16_t holdTime3=0);
+
+  // Reads the button and returns the gesture that was recognised, or none.
+  // Should be called frequently, for example from the main loop.
+  gesture_t update(void);
+
+  // The hold level (1..3) that was reached during the last hold gesture.
+  uint8_t holdLevel(void) {return _level;}
+
+  // Ignore the button until it has been released.
+  void waitForRelease(void) {_state = waitFree;}
+
+private:
+  typedef enum {waitFree, idle, pressed, released, holding} state_t;
+  DccButton *_button;
+  state_t _state;
+  uint8_t _clicks;                // Number of clicks thus far
+  uint8_t _level;                 // Hold level reached
+  uint16_t _clickGap = 400;       // ms
+  uint16_t _holdTime[3] = {1000, 0, 0};
+};
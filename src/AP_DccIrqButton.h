@@ -0,0 +1,128 @@
+//*******************************************************************************************
+//
+// file:      AP_DccIrqButton.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0   Initial version
+//            2026-10-18 V1.1   32 bit time of the last state change
+//            2026-10-18 V1.2   All irqQueueSize queue entries are used
+//
+// purpose:   Interrupt driven (debounced) buttons
+//
+// A DccButton must be polled: if read() is not called often enough, for example because the
+// main loop is temporarily busy, short presses may be missed. In addition, every read() costs
+// a millis() call, even if nobody touches the button.
+// A DccIrqButton is instead driven by an edge interrupt. The interrupt service routine
+// only stores a timestamp and the pin level of each edge in a small queue. Debouncing and
+// classification (pressed, released, long press) is done lazily, at the moment the main sketch
+// asks for the button state. Idle buttons therefore cost (almost) nothing.
+//
+// The queue is a single producer (ISR) / single consumer (main) ring buffer. The ISR is the
+// only one that modifies `head`, the main sketch is the only one that modifies `tail`, so no
+// locking is needed. Both are free running counters; the queue entry is the counter modulo
+// irqQueueSize, and head - tail is the number of queued edges. All irqQueueSize entries can
+// therefore be used. If the queue overflows (more than irqQueueSize edges between two queries),
+// further edges are dropped, and the button state is resynchronised by reading the pin once the
+// bouncing has stopped.
+//
+// Edge timestamps are stored as the lower 16 bits of millis(), to save RAM and keep the ISR
+// short. read() converts them into full millis() values, so pressedFor() and releasedFor() work
+// for any period. This conversion assumes that queued edges are processed within 65 seconds;
+// a sketch that queries the button less often should call read() from the main loop.
+//
+// The interrupt is installed with attachInterrupt(), with mode CHANGE. On MegaCoreX and DxCore
+// boards this works for all pins. On traditional ATMega processors (such as the 16, 328 and 2560)
+// attachInterrupt() only supports the external interrupt pins (INTx); the pin change interrupts
+// (PCINT) of the other pins are not used, and attach() returns false for such pins. Note that the
+// DCC and RS-Bus inputs also use INTx pins.
+//
+//*******************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define maxIrqButtons     4       // Maximum number of interrupt driven buttons
+#define irqQueueSize      8       // Edges stored per button. Should be a power of 2, at most 8
+                                  // (queue levels are stored as bits of a uint8_t)
+
+
+class DccIrqButton {
+
+public:
+  // attach(pin, dbTime, puEnable, invert) initialises a button object.
+  // The parameters are the same as for DccButton.
+  // Returns false if the pin does not support interrupts, or if the maximum number of
+  // interrupt driven buttons (maxIrqButtons) has been reached.
+  bool attach(uint8_t pin, uint8_t dbTime=25, bool puEnable=true, bool invert=true);
+
+  // Processes the edges queued by the ISR and returns the debounced state (true = pressed).
+  // Calling read() is optional, since all functions below call it themselves.
+  bool read();
+
+  bool isPressed();
+  bool isReleased();
+
+  // Returns true if the button was pressed (released) since the previous call.
+  // As opposed to DccButton, presses are counted. If the button was pressed twice since the
+  // previous call, wasPressed() will return true for the next two calls.
+  bool wasPressed();
+  bool wasReleased();
+
+  // Returns true if the button is pressed (released) for at least the given time.
+  bool pressedFor(unsigned long ms);
+  bool releasedFor(unsigned long ms);
+
+  // Should only be called by the interrupt routine
+  void isr();
+
+protected:
+  uint8_t m_dbTime;                   // debounce time (ms)
+  bool m_invert;                      // if true, interpret logic low as pressed
+  bool m_state;                       // debounced button state, true=pressed
+  bool m_settle;                      // edges seen: recheck the pin after the bounces
+  uint8_t m_pressCount;               // presses not yet reported by wasPressed()
+  uint8_t m_releaseCount;             // releases not yet reported by wasReleased()
+  unsigned long m_lastChange;         // time of the last debounced state change (ms)
+  uint8_t m_bit;                      // Bitmask for reading the input Port
+  volatile uint8_t *m_portRegister;   // Input register of the port
+
+  // Edge queue, filled by the ISR
+  volatile uint8_t m_head;            // edges stored (free running), modified by the ISR only
+  uint8_t m_tail;                     // edges processed (free running), modified by read() only
+  volatile uint8_t m_levels;          // bit n: pin level of queue entry n
+  volatile bool m_overflow;           // an edge was dropped since the queue was full
+  volatile uint16_t m_lastEdge;       // time of the most recent edge (ms)
+  volatile uint16_t m_edgeTime[irqQueueSize];
+
+  void accept(bool level, unsigned long time);
+};
+
+
+//*******************************************************************************************
+// IrqToggleButton
+// A derived class for a "push-on, push-off" (toggle) type button.
+// initial state can be given, default is off (false).
+//*******************************************************************************************
+class IrqToggleButton : public DccIrqButton {
+
+public:
+  bool attach(uint8_t pin, uint8_t dbTime=25, bool puEnable=true,
+              bool invert=true, bool initialState=false) {
+    m_toggleState = initialState;
+    m_changed = false;
+    return DccIrqButton::attach(pin, dbTime, puEnable, invert);
+  }
+
+  // Every press since the previous call toggles the state. No press will be missed.
+  bool toggleState() {
+    bool oldState = m_toggleState;
+    while (wasPressed()) m_toggleState = !m_toggleState;
+    m_changed = (m_toggleState != oldState);
+    return m_toggleState;
+  }
+
+  // has the state changed during the last call of toggleState()?
+  bool changed() {return m_changed;}
+
+private:
+  bool m_toggleState;
+  bool m_changed;
+};
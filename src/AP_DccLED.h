@@ -6,6 +6,7 @@
 //            2021-06-26 V1.2   ap extended with fade out
 //            2022-07-20 V1.3   ap split into multiple objects, to save RAM if methods are not needed
 //            2022-08-02 V1.4   ap const static uint8_t replaced by #defines
+//            2026-10-18 V1.5   ap direct port access (DccFastPin) instead of digitalWrite()
 //
 // purpose:   LED object. LED can be switched on, switched off, put in flashing mode or fade out.
 //            Next to these basic modes, additional functions are defined for some common tasks,
@@ -17,14 +18,15 @@
 // - DccLed:      extends FlashLed with DCC decoder specific functions (start_up, activity, feedback)
 // - FadeOutLed:  extends BasicLed with fadeOut (not recommeded: is expensive regarding RAM and CPU)
 //
-// RAM required per object:
-// - BasicLed:     2
-// - FlashLed:    11
-// - DccLed:      11
-// - FadeOutLed:  23
+// RAM required per object (AVR):
+// - BasicLed:     4
+// - FlashLed:    13
+// - DccLed:      13
+// - FadeOutLed:  25
 //
 //******************************************************************************************************
 #pragma once
+#include "AP_DccFastPin.h"
 
 
 //******************************************************************************************************
@@ -39,7 +41,7 @@ public:
   void toggle(void);
 
 protected:
-  uint8_t _pin;                                    // Hardware pin to which the LED is connected
+  DccFastPin _pin;                                 // Hardware pin to which the LED is connected
   bool _LED_ON;                                    // Default for _LED_ON is HIGH, but may be inverted
 };
 
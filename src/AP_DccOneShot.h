@@ -0,0 +1,83 @@
+//*****************************************************************************************************
+//
+// File:      AP_DccOneShot.h
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//            2026/10/18 AP Version 1.1 Hardware timer only if DCC_CORE_ONESHOT is set
+//            2026/10/18 AP Version 1.2 Without hardware timer, callbacks run with interrupts enabled
+//
+// Purpose:   One-shot timers with microsecond resolution, driven by a hardware timer
+//
+// A DccTimer has millisecond resolution, and expiry is only detected once the main sketch polls
+// the timer. Actions that need precise timing, such as coil pulses or servo pulses, are therefore
+// stretched by the duration of the main loop. A DccOneShot timer instead uses the compare
+// interrupt of a hardware timer. Once the deadline is reached, the callback function is called:
+// - directly from the interrupt service routine (default), or
+// - deferred: from DccOneShot::update(), which should then be called from the main loop.
+//
+// Callbacks that run in interrupt context should be short, and should not use Serial or delay().
+//
+// Multiple DccOneShot timers (maximum: maxOneShots) share a single hardware compare channel.
+// The hardware is programmed for the timer with the earliest deadline; after it fires, the
+// hardware is reprogrammed for the next one. Deadlines are stored as micros() values, thus
+// timers may run up to some 35 minutes. Deadlines beyond the range of the hardware timer are
+// reached in multiple steps.
+//
+// The hardware timer is only used if DCC_CORE_ONESHOT is set to 1 in core_features.h (default: 0).
+// Since the library objects are linked into every sketch that uses the core, an interrupt service
+// routine in this library would otherwise take the timer away from all sketches. The timer itself
+// is only programmed once the first DccOneShot is started.
+// If DCC_CORE_ONESHOT is 0, no timer is used, and all callbacks are called from update(), as for
+// deferred timers; interrupts are not disabled while a callback runs.
+//
+// The following hardware timers are used:
+// - Traditional ATMega processors (16, 328, 2560): Timer1, compare channel A (prescaler 8).
+//   Timer1 is also used by the Servo library (the link fails with "multiple definition of
+//   __vector_11"), and analogWrite() no longer works on the Timer1 pins (9 and 10 on the UNO).
+// - MegaAVR (4808, 4809) and DA/DB processors: TCB1 (clock: CPU clock / 2).
+//   Note that the AP_DCC_library uses another TCB, and millis() yet another one. If TCB1 is
+//   already in use, change oneShotTCB and oneShotTCB_vect in DccOneShot.cpp.
+// - Other architectures: no hardware timer is used, and all callbacks are called from update().
+//
+// The accuracy is determined by the interrupt latency and the resolution of micros()
+// (4us on a 16MHz ATMega328, 1us on most MegaAVR and DA/DB boards). Examples/Timer/OneShot-Jitter
+// measures the actual deviation.
+//
+//*****************************************************************************************************
+#pragma once
+#include <Arduino.h>
+#include "core_features.h"
+
+#define maxOneShots     4           // Maximum number of DccOneShot timers running at the same time
+
+typedef void (*oneShotCallback_t)(void);
+
+
+class DccOneShot {
+  public:
+    // Starts (or restarts) the timer. After `us` microseconds the callback is called.
+    // If deferred is true, the callback is called from update() instead of the ISR.
+    // Returns false if already maxOneShots other timers are running.
+    bool start(unsigned long us, oneShotCallback_t callback, bool deferred = false);
+
+    // Stops the timer. The callback will not be called.
+    void stop(void);
+
+    // Returns true if the timer was started, and the callback has not yet been called.
+    bool running(void);
+
+    // Calls the callbacks of deferred timers that have expired. Should be called as often as
+    // possible from main, if deferred timers are used (or if no hardware timer is available).
+    static void update(void);
+
+    // Called by the interrupt service routine. Should not be called by the main sketch.
+    static void service(void);
+
+  private:
+    static void reschedule(unsigned long now);    // Program the hardware for the next deadline
+    typedef enum {idle, armed, fired} state_t;
+    volatile state_t _state;
+    bool _deferred;
+    unsigned long _deadline;        // micros() value
+    oneShotCallback_t _callback;
+};
@@ -4,16 +4,38 @@
 // author:    Aiko Pras
 // history:   2022-05-25 V1.0 ap: Initial version
 //            2022-07-17 V1.1 ap: changed to replace the timer library
+//            2026-10-18 V1.2 ap: commands received while a coil is active are remembered
+//            2026-10-18 V1.3 ap: optional coil scheduler, to limit the number of active coils
+//            2026-10-18 V1.4 ap: optional persistent position (DccStateStore)
+//            2026-10-18 V1.5 ap: PWM hold and mono-stable relays
+//            2026-10-18 V1.6 ap: direct port access for the coil pins (DccFastPin)
+//            2026-10-18 V1.7 ap: activate() first handles an expired hold time
+//            2026-10-18 V1.8 ap: the scheduler is only released for a coil it granted
 //
-// purpose:   Relay object. Relays are bi-stable, and have two coils.
+// purpose:   Relay object. Relays are normally bi-stable, and have two coils.
 //            Relay can be switched to POS1 or POS2.
 //            At startup, the relay may be in an UNKNOWN state
 //            The time an activation command will hold, should be specified in 20ms steps, to be
 //            consistent with existing CV values.
+//            A command that is received while a coil is still active, is stored in a pending
+//            slot and executed by update() once the hold time has passed. If multiple commands
+//            are received, the latest command wins.
+//            Optionally relays can be coupled to a DccCoilScheduler. Coils are then only
+//            activated once the scheduler grants permission (see AP_DccCoilScheduler.h).
+//            If a DccStateStore is given to init(), the position is restored from EEPROM, and
+//            each new position is stored (see AP_DccStateStore.h).
+//            Optionally, the coil is not switched off after the hold time, but held with a
+//            (hardware) PWM signal with reduced duty cycle (see setPwmHold()). Mono-stable relays
+//            have a single coil; they are used by giving pinPos1 and pinPos2 the same value.
+//            POS2 energises the coil, POS1 releases it.
 //
 //******************************************************************************************************
 #pragma once
 #include <AP_DccTimer.h>      // For the timers
+#include "AP_DccFastPin.h"    // For fast access to the coil pins
+
+class DccCoilScheduler;
+class DccStateStore;
 
 
 class relayClass {
@@ -21,15 +43,44 @@ class relayClass {
     // A relay may be in / switch to one of the following states
     typedef enum {POS1, POS2, UNKNOWN} rState_t;
     rState_t state;                   // Current state
+    uint16_t coalesced;               // Number of pending commands replaced by a newer command
+    uint16_t dropped;                 // Number of pending commands cancelled, since no longer needed
 
-    void init(uint8_t pinPos1, uint8_t pinPos2, uint8_t holdTime);
+    // store / index: optional, to restore and store the position in EEPROM
+    void init(uint8_t pinPos1, uint8_t pinPos2, uint8_t holdTime,
+              DccStateStore *store = nullptr, uint8_t index = 0);
     void activate(rState_t newState); // to switch to a new state
     void update();                    // should be called as frequent as possible from main
 
+    // Optional: coils are activated once the scheduler grants permission.
+    // priority: higher values are granted first (if the scheduler uses priority order)
+    void useScheduler(DccCoilScheduler *scheduler, uint8_t priority = 0);
+
+    // Optional: after holdTime the coil is held with a PWM signal with this duty cycle (1..255),
+    // till the relay is switched to the other position. 0 (default): coil is switched off.
+    // The coil pins should support hardware PWM (analogWrite).
+    void setPwmHold(uint8_t duty);
+
   private:
+    friend class DccCoilScheduler;
+    bool grant();                     // called by the scheduler. Returns true if a coil is activated
+    bool switchCoil(rState_t newState);   // Returns true if a coil is activated
+    void coilOff(rState_t position);  // Switches the coil off, including a PWM hold
+    void endPullIn();                 // After holdTime: PWM hold or coil off, release scheduler
+    uint8_t _pwmDuty = 0;             // 0: no PWM hold
+    DccCoilScheduler *_scheduler = nullptr;
+    uint8_t _priority = 0;
+    bool _waiting = false;            // waiting for permission from the scheduler
+    bool _granted = false;            // the active coil was granted by the scheduler
+    DccStateStore *_store = nullptr;
+    uint8_t _storeIndex = 0;
+
     DccTimer relayTimer;              // Timer object to switch off (any of the two) coils
     uint8_t _pinPos1;                 // Arduino pin to activate Coil 1
     uint8_t _pinPos2;                 // Arduino pin to activate Coil 2
+    DccFastPin _coil1;                // Port and bit of _pinPos1
+    DccFastPin _coil2;                // Port and bit of _pinPos2
     uint8_t _holdTime;                // in 20ms steps
+    rState_t _pending;                // Command to execute after the hold time (UNKNOWN: none)
 };
 
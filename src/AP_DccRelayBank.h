@@ -0,0 +1,117 @@
+//******************************************************************************************************
+//
+// file:      AP_DccRelayBank.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//            2026-10-18 V1.1 ap: pulse() is limited to maxRelayPulse (32767 ms)
+//            2026-10-18 V1.2 ap: DccRoundRobin::command() takes on / off (the DCC position)
+//
+// purpose:   Bank of 16 (mono-stable) relays, connected to two 8 bit output ports.
+//            DccRoundRobin implements the operating modes of the Relays-16 decoder on top.
+//
+// The Relays-16 decoder connects relays 1-8 to Port C and relays 9-16 to Port A. Driving each
+// relay with its own relayClass object means one pinMode / digitalWrite and one DccTimer per
+// relay. The DccRelayBank instead keeps the state of all 16 relays in a single bitmask (bit 0 is
+// relay 1, bit 15 is relay 16), and writes changes to both ports with masked port writes. The
+// Ract CV (relays switch with - (=0) or with + (=1)) is applied as an XOR mask, so that
+// switching all 16 relays costs two register stores.
+//
+// Relays may also be switched on for a limited time (pulse). Instead of a timer per relay, a
+// small shared deadline table (maxRelayDeadlines entries) is used: each entry holds a bitmask of
+// relays and the (16 bit) millis() value at which these relays should be switched off. Relays
+// that are pulsed with the same deadline share an entry. update() calls millis() only once.
+//
+// The port of the first relay (relay 1 and relay 9) is derived from the Arduino pin numbers given
+// to attach(). Relay 1 is bit 0 of that port, relay 2 bit 1, etc.
+//
+// DccRoundRobin implements the operating modes of the Relays-16 decoder, as selected by the
+// Mode CV:
+// 0: an on command switches the relay on, and all other relays off.
+// 1: same as 0, but an off command switches the relay off.
+// 2: multiple relays may be on at the same time. On switches the relay on, off switches it off.
+// 3: round-robin: the relays selected by the RRR1 / RRR2 CVs are switched on one after the
+//    other, each for RInter seconds. Relays not selected behave as in mode 2.
+// On and off are the position of the DCC accessory command (+ and -). The activate flag of the
+// command is not suited: for every button press, most command stations send an activate,
+// followed by a deactivate for the same position.
+// State changes are reported via a callback function, for example to send RS-Bus feedback.
+// DccRoundRobin uses no dynamic memory, and calls millis() at most once per update().
+//
+//******************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define maxRelayDeadlines   4       // Number of different pulse deadlines that may run simultaneously
+#define maxRelayPulse       32767   // Longest pulse (ms) that fits the 16 bit deadlines
+
+
+class DccRelayBank {
+  public:
+    // pinRelay1:  Arduino pin of relay 1; relays 1-8 are on that port (bit 0..7)
+    // pinRelay9:  Arduino pin of relay 9; relays 9-16 are on that port (bit 0..7)
+    // activeHigh: value of the Ract CV. If false, relays are switched on by a low output
+    void attach(uint8_t pinRelay1, uint8_t pinRelay9, bool activeHigh = true);
+
+    void on(uint8_t relay);                     // relay: 0..15
+    void off(uint8_t relay);
+    void set(uint16_t mask);                    // Switch on all relays in mask, all others off
+    void change(uint16_t onMask, uint16_t offMask);
+
+    // Switch on all relays in mask, and switch them off after ms milliseconds.
+    // Longer pulses are shortened to maxRelayPulse (32767 ms).
+    void pulse(uint16_t mask, uint16_t ms);
+
+    bool isOn(uint8_t relay);
+    uint16_t state() {return _state;}           // bit n = relay n+1, 1 = on
+
+    void update();                              // should be called as frequent as possible from main
+
+  private:
+    struct deadline_t {
+      uint16_t mask;                            // Relays to switch off, 0 = entry not in use
+      uint16_t due;                             // Lower 16 bits of millis()
+    };
+    deadline_t _deadline[maxRelayDeadlines];
+    volatile uint8_t *_port1;                   // Output register for relays 1-8
+    volatile uint8_t *_port2;                   // Output register for relays 9-16
+    uint16_t _state = 0;
+    uint16_t _polarity = 0;                     // XOR mask: 0xFFFF if relays switch with -
+
+    void commit();
+    void cancelPulse(uint16_t mask);
+};
+
+
+class DccRoundRobin {
+  public:
+    // Called after relays changed. state: all relays, changed: relays that changed
+    typedef void (*changeCallback_t)(uint16_t state, uint16_t changed);
+
+    // bank:     the relays, should already be attached
+    // mode:     value of the Mode CV (0..3)
+    // rrMask:   relays used for round-robin: RRR1 | (RRR2 << 8)
+    // interval: round-robin interval in seconds (RInter CV). 0 stops the round-robin
+    // onChange: optional callback
+    void attach(DccRelayBank *bank, uint8_t mode, uint16_t rrMask, uint8_t interval,
+                changeCallback_t onChange = nullptr);
+
+    // To be called for each (activate) DCC accessory command. relay: 0..15
+    // on: true switches the relay on, false off. For DCC commands: accCmd.position (1 = +)
+    void command(uint8_t relay, bool on);
+
+    uint8_t current() {return _current;}        // round-robin relay that is on (0..15)
+
+    void update();                              // should be called as frequent as possible from main
+
+  private:
+    DccRelayBank *_bank;
+    changeCallback_t _onChange;
+    uint16_t _rrMask;
+    unsigned long _interval;                    // in ms
+    uint8_t _mode;
+    uint8_t _current;
+    unsigned long _lastStep;
+
+    void apply(uint16_t onMask, uint16_t offMask);
+    void step();
+};
@@ -0,0 +1,83 @@
+//*****************************************************************************************************
+//
+// File:      AP_DccSignalQuality.h
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   Rolling window statistics of DCC and RS-Bus errors
+//
+// The AP_DCC_library and the RSbus library count errors in 8 bit counters: dcc.errorXOR,
+// rsbusHardware.parityErrors and rsbusHardware.pulseCountErrors. PoM reads of CV26, CV31 and CV32
+// return these counters, which wrap at 255 and tell nothing about when the errors occurred.
+// A DccErrorStats object therefore samples such counter once per second, and keeps:
+// - the number of errors during the last second,
+// - the number of errors during the last qualityWindows (8) seconds (rolling window),
+// - the highest number of errors in a single second (peak rate) since startup,
+// - the number of seconds since the last error (255: no error during the last 255 seconds).
+// Each sample takes a subtraction, a ring buffer step and a few compares.
+//
+// The core contains a DccSignalQuality object, signalQuality, that keeps these statistics for the
+// three counters. They can be read via PoM (verify byte), as read-only diagnostic CVs:
+//
+//   CV   | DCC (errorXOR) | RS-Bus parity | RS-Bus pulse count
+//   -----+----------------+---------------+-------------------
+//   last |      240       |      244      |      248
+//   8 s  |      241       |      245      |      249
+//   peak |      242       |      246      |      250
+//   age  |      243       |      247      |      251
+//
+// Two further diagnostic CVs tell how long the last start-up took, in steps of 10ms (255: 2.55
+// seconds or longer), see decoderHardware:
+// - CV252: time till the start-up was completed (readyTime)
+// - CV253: time till the first answer to a feedback request of the master was queued (answerTime,
+//          0: none). The answer is sent on the RS-Bus at the next poll of the address.
+//
+// These CV numbers are below 256, so they exist on every processor (the 4808/4809 have 256 bytes
+// EEPROM). Writes to these CVs are ignored.
+//
+//*****************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define qualityWindows  8           // Number of 1 second windows in the rolling window
+#define diagnosticCvs   240         // First diagnostic CV
+#define diagnosticCount 14          // Number of diagnostic CVs
+
+
+class DccErrorStats {
+  public:
+    void init(uint8_t counter);                   // counter: the current value of the error counter
+    void sample(uint8_t counter);                 // Should be called once per second
+
+    uint8_t lastSecond(void) {return _ring[_head];}
+    uint8_t window(void) {return (_sum > 255) ? 255 : _sum;}
+    uint8_t peak(void) {return _peak;}
+    uint8_t age(void) {return _age;}              // Seconds since the last error (max 255)
+
+  private:
+    uint8_t _counter;                             // Counter value at the previous sample
+    uint8_t _ring[qualityWindows];                // Errors per second
+    uint8_t _head;                                // Position of the last second in _ring
+    uint16_t _sum;                                // Sum of _ring
+    uint8_t _peak;
+    uint8_t _age;
+};
+
+
+class DccSignalQuality {
+  public:
+    DccErrorStats dccSignal;                      // dcc.errorXOR
+    DccErrorStats rsParity;                       // rsbusHardware.parityErrors
+    DccErrorStats rsPulse;                        // rsbusHardware.pulseCountErrors
+
+    void init(void);                              // Called by decoderHardware.init()
+    void update(unsigned long now);               // Called every 20ms by decoderHardware.update()
+
+    bool isDiagnosticCv(unsigned int number) {
+      return ((number >= diagnosticCvs) && (number < diagnosticCvs + diagnosticCount));
+    }
+    uint8_t read(unsigned int number);            // Value of a diagnostic CV
+
+  private:
+    unsigned long _lastSample;
+};
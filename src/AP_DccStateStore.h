@@ -0,0 +1,68 @@
+//******************************************************************************************************
+//
+// file:      AP_DccStateStore.h
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Stores relay / turnout positions in EEPROM, such that they survive a power cycle.
+//
+// After a reboot, relayClass objects start in the UNKNOWN state, so the decoder can not report
+// meaningful feedback till the PC has sent a command for every turnout. With a DccStateStore the
+// positions are stored in EEPROM, and restored by relayClass::init().
+//
+// Positions are stored as 2 bit values (maximum: maxStoredPositions). Changes are not written
+// immediately, but once no further changes were made during `delay` ms. This way a route that
+// sets many turnouts results in a single EEPROM write, and the command path is not slowed down.
+// Writing itself is also spread over multiple calls of update(): one byte per call, and only if
+// the EEPROM is ready, so update() never waits for the EEPROM.
+//
+// To spread the wear of the EEPROM cells, the EEPROM area is used as a ring of records. Each
+// write uses the next record. A record consists of the positions, a sequence number and a check
+// byte. At startup the most recent valid record is searched. A record that was only partially
+// written (power loss during the write) has an incorrect check byte, and is ignored.
+//
+//    start                                                              start + size
+//    +-------------------+-------------------+-------------------+----- ... -----+
+//    | pos | seq | check | pos | seq | check | pos | seq | check |               |
+//    +-------------------+-------------------+-------------------+----- ... -----+
+//
+// The EEPROM area should not overlap with the CVs. A good location is the end of the EEPROM:
+//   store.attach(E2END + 1 - 100, 100);
+//
+//******************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define maxStoredPositions  32      // Maximum number of positions (2 bits each)
+#define storedBytes         (maxStoredPositions / 4)
+#define storedRecordSize    (storedBytes + 2)
+
+
+class DccStateStore {
+  public:
+    // start: first EEPROM address of the area, size: number of bytes of the area (at least one
+    // record of storedRecordSize bytes; at most 255 records are used).
+    // delay: time in ms without changes, before the positions are written.
+    // Reads the most recent record. If no valid record is found, all positions become 0x03.
+    void attach(uint16_t start, uint16_t size, uint16_t delay = 2000);
+
+    uint8_t get(uint8_t index);                   // Returns the position (0..3)
+    void set(uint8_t index, uint8_t value);       // Stores the position (0..3)
+    bool busy() {return _dirty || (_writePos < storedRecordSize);}
+
+    void update();                                // should be called as frequent as possible from main
+
+  private:
+    uint8_t _positions[storedBytes];              // Current positions
+    uint8_t _record[storedRecordSize];            // Record being written
+    uint16_t _start;
+    uint8_t _records;                             // Number of records in the ring
+    uint8_t _current;                             // Record that holds the most recent positions
+    uint8_t _writePos = storedRecordSize;         // Next byte of _record to write
+    uint8_t _seq;
+    bool _dirty = false;
+    uint16_t _delay;
+    unsigned long _lastChange;
+
+    uint8_t check(const uint8_t *record);
+};
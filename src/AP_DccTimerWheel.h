@@ -0,0 +1,85 @@
+//*****************************************************************************************************
+//
+// File:      AP_DccTimerWheel.h
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   Timer service for decoders that need many timers
+//
+// Every DccTimer object stores its own runTime and startTime, and calls millis() each time
+// running() or expired() is called. A decoder with 16 relays, 24 IO channels or 8 occupancy
+// delays therefore polls dozens of timers, and calls millis() dozens of times, every loop.
+//
+// The DccTimerWheel manages many timers together. Timers are identified by a (one byte)
+// handle, and call a callback function upon expiry. update() reads millis() once, and
+// advances the wheel one bucket per tick. Only the timers in that bucket are visited, so the
+// cost per tick depends on the number of timers that (nearly) expire, and not on the total
+// number of timers.
+//
+//      tick -->  +----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+
+//      cursor    |  0 |  1 |  2 |  3 |  4 |  5 |  6 |  7 |  8 |  9 | 10 | 11 | 12 | 13 | 14 | 15 |
+//                +----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+
+//                          |                   |
+//                        timer 3             timer 7 (rounds = 2) -> timer 12 (rounds = 0)
+//
+// A timer that should expire after T ticks is stored in bucket (cursor + T) mod 16, with
+// rounds = (T - 1) / 16. Each time the cursor passes that bucket, rounds is decremented;
+// the timer expires once rounds is 0.
+//
+// The application provides the memory for the timers (6 bytes per timer), so no dynamic
+// memory is needed:
+//
+//   DccWheelSlot slots[24];
+//   DccTimerWheel timers;
+//   timers.attach(slots, 24);
+//
+//*****************************************************************************************************
+#pragma once
+#include <Arduino.h>
+
+#define wheelSize       16          // Number of buckets. Should be a power of 2
+#define noTimer         0xFF        // Returned by create() if no timer is available
+
+typedef void (*wheelCallback_t)(uint8_t handle);
+
+struct DccWheelSlot {
+  wheelCallback_t callback;         // Called upon expiry
+  uint16_t rounds;                  // Number of wheel rotations before expiry
+  uint8_t next;                     // Next timer in the same list
+  uint8_t where;                    // Bucket number, or expired / not running
+};
+
+
+class DccTimerWheel {
+  public:
+    // Provides the memory for count timers, and sets the duration of a tick in ms (default 10).
+    void attach(DccWheelSlot *slots, uint8_t count, uint8_t tickTime = 10);
+
+    // Reserves a timer, and returns its handle (or noTimer if all timers are in use).
+    uint8_t create(wheelCallback_t callback);
+
+    // Starts (or restarts) the timer. The callback will be called between ms and
+    // ms + tickTime milliseconds from now. May be called from within a callback.
+    void start(uint8_t handle, unsigned long ms);
+
+    // Stops the timer. The callback will not be called.
+    void stop(uint8_t handle);
+
+    // Returns true if the timer was started, and has not yet expired or been stopped.
+    bool running(uint8_t handle);
+
+    // Should be called as often as possible from main.
+    void update(void);
+
+  private:
+    DccWheelSlot *_slots;
+    uint8_t _count;                 // Number of slots provided
+    uint8_t _used;                  // Number of slots created
+    uint8_t _tickTime;              // ms
+    uint8_t _cursor;                // Current bucket
+    uint8_t _expired;               // List of timers of which the callback should be called
+    unsigned long _lastTick;
+    uint8_t _bucket[wheelSize];     // Head of the list per bucket
+
+    void unlink(uint8_t handle);
+};
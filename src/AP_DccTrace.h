@@ -0,0 +1,85 @@
+//*****************************************************************************************************
+//
+// File:      AP_DccTrace.h
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   Binary trace buffer for runtime diagnostics
+//
+// Serial.print() blocks once the transmit buffer is full, and thereby changes the timing of the
+// decoder it is supposed to observe. DccTrace instead stores events in a small ring buffer in RAM.
+// Each event (5 bytes) consists of an event ID, the lower 16 bits of millis() and two payload
+// bytes. Storing an event takes a few microseconds, and never waits for the UART.
+// The buffer is sent to the UART:
+// - by update(), but only as many events as fit in the free space of the transmit buffer, or
+// - by dump(), which sends all events and waits till the UART has accepted them.
+//
+// The core stores events for: programming commands, CV writes, PoM answers, address programming,
+// relay activation and reboots. Sketches may add their own events (IDs traceUser and higher).
+// If the buffer is full, new events are counted as lost. Once there is room again, a traceLost
+// event tells how many events were lost.
+//
+// Tracing is disabled by default, since the buffer takes RAM. It is enabled by setting
+// DCC_CORE_TRACE to 1 in core_features.h (or with the compiler flag -DDCC_CORE_TRACE=1). If tracing
+// is disabled, the dccTrace() macro is empty, and the traceBuffer object does not exist.
+//
+// Each event is sent as a frame of 7 bytes: 0xA5, id, time (low, high), a, b, checksum (XOR of the
+// 5 bytes before). extras/dcctrace.py converts these frames into a readable timeline.
+//
+//*****************************************************************************************************
+#pragma once
+#include <Arduino.h>
+#include "core_features.h"
+
+#define traceSize       32          // Number of events in the buffer. Should be a power of 2
+
+// Event IDs used by the core
+#define traceLost       0x01        // a: number of lost events (max 255)
+#define traceProgCmd    0x02        // a: 0 = SM, 1 = PoM, b: CvAccess operation
+#define traceCvWrite    0x03        // a: CV number (low byte), b: new value
+#define tracePomAnswer  0x04        // a: value that is send via RS-Bus address 128
+#define traceAddress    0x05        // a: CV1, b: CV9 (address programming via the button)
+#define traceRelay      0x06        // a: pin of coil 1, b: new position
+#define traceReboot     0x07
+#define traceUser       0x80        // First event ID available for the main sketch
+
+
+class DccTrace {
+  public:
+    // port: the UART to which events are send. The UART should already be initialised
+    void attach(Print &port);
+
+    // Stores an event. May be called from interrupt service routines
+    void log(uint8_t id, uint8_t a = 0, uint8_t b = 0);
+
+    // Sends as many events as fit in the free space of the UART transmit buffer.
+    // Should be called as often as possible from main.
+    void update(void);
+
+    // Sends all events. Waits till the UART has accepted them.
+    void dump(void);
+
+  private:
+    struct event_t {
+      uint8_t id;
+      uint16_t time;                // lower 16 bits of millis()
+      uint8_t a;
+      uint8_t b;
+    };
+    event_t _events[traceSize];
+    volatile uint8_t _head;         // next event to write
+    volatile uint8_t _tail;         // next event to send
+    volatile uint8_t _lost;         // events lost since the buffer became full
+    Print *_port = nullptr;
+
+    void store(uint8_t id, uint16_t time, uint8_t a, uint8_t b);
+    void send(const event_t &event);
+};
+
+
+#if DCC_CORE_TRACE
+  extern DccTrace traceBuffer;
+  #define dccTrace(id, a, b)  traceBuffer.log(id, a, b)
+#else
+  #define dccTrace(id, a, b)
+#endif
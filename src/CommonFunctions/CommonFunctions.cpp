@@ -5,18 +5,32 @@
 // History:   2021/06/14 AP Version 1.0
 //            2021/12/30 AP Version 1.2
 //            2022/08/02 AP Version 1.3
+//            2026/10/18 AP Version 1.4 Subsystems can be excluded (see core_features.h)
+//            2026/10/18 AP Version 1.5 Trace events (see AP_DccTrace.h)
+//            2026/10/18 AP Version 1.6 Multiple accessory addresses (see AP_DccAddressSet.h)
+//            2026/10/18 AP Version 1.7 Command dispatch per output (see AP_DccDispatcher.h)
+//            2026/10/18 AP Version 1.8 Change driven RS-Bus feedback (see AP_DccFeedback.h)
+//            2026/10/18 AP Version 1.9 Signal quality statistics (see AP_DccSignalQuality.h)
+//            2026/10/18 AP Version 1.10 Staged start-up, with ready time and first answer time
+//            2026/10/18 AP Version 1.11 Host builds: reboot() calls hostReboot() (see extras/host)
+//            2026/10/18 AP Version 1.12 readCv(): the live value of a CV, as used by PoM feedback
+//            2026/10/18 AP Version 1.13 RS-Bus connections and feedback requests on every update()
 //
 // Purpose:   C++ file that implements the methods to act on DCC CV-messages and pushes on the 
 //            programming button. It can send RS-Bus messages and make changes to the LED.
 //           
 //*****************************************************************************************************
 #include "AP_DCC_Decoder_Core.h"      // Header file for this C++ file
+#include <EEPROM.h>                   // For EEPROM.length() on non-AVR builds
 
 class ProgButton {
   public:
     void attach(uint8_t pin);                     // Attach the onboard programming button
     void checkForNewDecoderAddress(void);         // Is the onboard programming button pushed?
     void addressProgramming(void);                // Store the new decoder / RS-Bus address in EEPROM
+
+  private:
+    void restoreLed(void);                        // LED back to its normal (address set / not set) mode
 };
 
 
@@ -29,15 +43,34 @@ class ProgButton {
 extern RSbusHardware rsbusHardware;   // Instantiated in rs_bus.cpp
 // The second object manages POM feedback messages, using RS-Bus address 128.
 // The RSbusConnection class is defined in the RSbus library
+#if DCC_CORE_POM_FEEDBACK
 RSbusConnection rsbusPom;             // Used for feedback on PoM messages (RS-bus address 128)
+#endif
 
+#if DCC_CORE_LED
 DccLed onBoardLed;                    // The DccLed class is defined in the AP_DccLED Library
+#endif
+#if DCC_CORE_PROG_BUTTON
 DccButton onBoardButton;              // The DccButton class is defined in the AP_DccButton Library
+DccGesture progGesture;               // Recognises clicks and holds on the onBoardButton
+#endif
 
 // Classes defined in here
+#if DCC_CORE_PROG_BUTTON
 ProgButton progButton;                // The onBoardButton is used as programming button
+#endif
 CvProgramming cvProgramming;          // For actions after a CV-access commandis received
 Processor processor;                  // Instantiate the Processor's object, which is used for reboot
+DccAddressSet decoderAddresses;       // The accessory addresses of this decoder
+#if DCC_CORE_DISPATCH
+DccDispatcher commandDispatcher;      // Calls the handlers per output, once attached by the sketch
+#endif
+#if DCC_CORE_FEEDBACK
+DccFeedback rsFeedback;               // Sends feedback changes, once attached by the sketch
+#endif
+#if DCC_CORE_QUALITY
+DccSignalQuality signalQuality;       // Errors per second of the DCC and RS-Bus signals
+#endif
 CommonDecHwFunctions decoderHardware; // Common inits(), and update of the LED and RS-Bus interfaces
 
 
@@ -54,38 +87,87 @@ void Processor::reboot(void) {
   // software reset. Using WDT has as advantage that all IO Registers will be set to their initial
   // value, but requires the use of (optiboot) bootloaders or special code during initialization.
   // A JMP to zero seems much simpler.
+  dccTrace(traceReboot, 0, 0);
+  #if DCC_CORE_TRACE
+  traceBuffer.dump();               // Events in RAM would otherwise be lost
+  #endif
   noInterrupts();
   dcc.detach();
   rsbusHardware.detach();
-  asm volatile("  jmp 0");
+  #if defined(__AVR__)
+    asm volatile("  jmp 0");
+  #else
+    hostReboot();                   // Host build: the shim decides what a reboot means
+  #endif
   interrupts();
 }
 
 
+#if DCC_CORE_PROG_BUTTON
 //*****************************************************************************************************
 // Programming button 
 //*****************************************************************************************************
-// The ProgButton class is basically a small wrapper around the DccButton class (see AP_DccButton)
+// The ProgButton class is basically a small wrapper around the DccButton class (see AP_DccButton).
+// The gestures on the button are recognised by a DccGesture object (see AP_DccGesture):
+// - single click:              address programming
+// - hold for 5 seconds:        the LED starts flashing fast. If the button is released now,
+//                              all EEPROM data is restored with default values.
+// - hold for 10 seconds:       the LED goes off; releasing the button has no effect.
+//                              This avoids that a button that is pressed by accident (or got
+//                              stuck) restores the default values.
+// - double and triple click:   not used (yet). May be used for other maintenance functions.
+// The gesture recogniser ignores the button until it has been released after attach(). Therefore
+// a pin that settles after power-on, or a button that is pressed at startup, will be ignored.
 void ProgButton::attach(uint8_t pin) {
   onBoardButton.attach(pin);
-  delay(500);
-  onBoardButton.read();
+  progGesture.attach(&onBoardButton);
+  progGesture.setTimes(400, 5000, 10000);
+}
+
+
+void ProgButton::restoreLed() {
+  #if DCC_CORE_LED
+  if (cvValues.addressNotSet()) onBoardLed.flashSlow();
+  else onBoardLed.turn_off();
+  #endif
 }
 
 
 void ProgButton::checkForNewDecoderAddress() {
-  // Check if the decoder programming button is pushed
-  // If the button is pushed for 5 seconds, restore all EEPROM data with default values.
-  // If it is just pushed shortly, enter address programming
-  onBoardButton.read();
-  if (onBoardButton.isPressed()) onBoardLed.turn_on();
-  if (onBoardButton.pressedFor(5000)) {
-      onBoardLed.turn_off();
-      cvValues.setDefaults();
-      delay(500);
-      processor.reboot();
-  }    
-  if (onBoardButton.wasReleased()) addressProgramming();
+  // Check if the decoder programming button is pushed, and which gesture is made
+  DccGesture::gesture_t gesture = progGesture.update();
+  #if DCC_CORE_LED
+  if (onBoardButton.wasPressed()) onBoardLed.turn_on();
+  #endif
+  switch (gesture) {
+    case DccGesture::click1:
+      addressProgramming();
+    break;
+    #if DCC_CORE_LED
+    case DccGesture::hold1:
+      onBoardLed.flashFast();                     // Warning: release now to restore defaults
+    break;
+    case DccGesture::hold2:
+      onBoardLed.turn_off();                      // Too long: factory reset is cancelled
+    break;
+    #endif
+    case DccGesture::holdEnd:
+      if (progGesture.holdLevel() == 1) {
+        #if DCC_CORE_LED
+        onBoardLed.turn_off();
+        #endif
+        cvValues.setDefaults();
+        processor.reboot();
+      }
+      restoreLed();
+    break;
+    case DccGesture::click2:
+    case DccGesture::click3:
+      restoreLed();
+    break;
+    default:
+    break;
+  }
 }
 
 
@@ -93,15 +175,25 @@ void ProgButton::addressProgramming() {
   // Set the decoder addresses:
   // CV1/CV9 (myAddrL/myAddrH): We store the output or decoder address, except for GBMs 
   // CV10 (myRSAddr): For GBM decoders we store the output address, for others the decoder address.
+  #if DCC_CORE_LED
   onBoardLed.flashFast();
+  #endif
   do {
+    #if DCC_CORE_LED
     onBoardLed.update();
+    #endif
     if (dcc.input()) {
       uint8_t cv29 = cvValues.read(Config);
       bool accDecoder = bitRead(cv29,7);       // Are we an accessory decoder?
       bool outputAddr = bitRead(cv29,6);       // Do we want output (or decoder) addressing?
+      // CV1 and CV9 can store output addresses up to 2047 and decoder addresses up to 510.
+      // Higher addresses would be stored as address 0, and are therefore ignored.
+      bool validAddress = outputAddr ? ((accCmd.outputAddress > 0) && (accCmd.outputAddress <= 2047))
+                                     : (accCmd.decoderAddress <= 510);
+      if (cvValues.isGBM()) validAddress = true;   // GBMs only store the RS-Bus address
       // Only act if we are an accessory decoder and receive an accessory commands 
-      if (accDecoder && ((dcc.cmdType == Dcc::MyAccessoryCmd) || (dcc.cmdType == Dcc::AnyAccessoryCmd))) {  
+      if (accDecoder && validAddress &&
+         ((dcc.cmdType == Dcc::MyAccessoryCmd) || (dcc.cmdType == Dcc::AnyAccessoryCmd))) {  
         // Step 1: Store the Output address or the Decoder address, unless we have a GBM decoder
         if (!cvValues.isGBM()) {      
           // According to RCN213, for the first handheld address (switch = 1) CV1 should become 1.
@@ -114,6 +206,7 @@ void ProgButton::addressProgramming() {
             uint8_t my_cv9 = ((accCmd.outputAddress >> 8) & 0b00000111);
             cvValues.write(myAddrL, my_cv1);
             cvValues.write(myAddrH, my_cv9);
+            dccTrace(traceAddress, my_cv1, my_cv9);
           }      
           else {
             // Store the decoder address:
@@ -124,6 +217,7 @@ void ProgButton::addressProgramming() {
             uint8_t my_cv9 = ((tempAddress >> 6) & 0b00000111);
             cvValues.write(myAddrL, my_cv1);
             cvValues.write(myAddrH, my_cv9);
+            dccTrace(traceAddress, my_cv1, my_cv9);
           }
         }
         // Step 2: Set the RS-bus address (1..127, 0 = undefined, 128 = PoM feedback)
@@ -145,11 +239,11 @@ void ProgButton::addressProgramming() {
     onBoardButton.read();
   } while (!onBoardButton.isPressed());
   // Button was pushed again, but no DCC accessory decoder message was received.
-  // No need to reboot().
-  onBoardLed.turn_off();
-  delay(500);
-  onBoardButton.read();;
+  // No need to reboot(). The release of this push should not be seen as a new click.
+  restoreLed();
+  progGesture.waitForRelease();
 }
+#endif // DCC_CORE_PROG_BUTTON
 
 
 //*****************************************************************************************************
@@ -173,7 +267,9 @@ void CvProgramming::initPoM() {
   }
   locoCmd.setMyAddress(pomAddress);
   // Feedback for CV PoM (verify byte) messages will be send via RS-bus address 128
+  #if DCC_CORE_POM_FEEDBACK
   rsbusPom.address = 128;        // 1.. 128
+  #endif
 }       
 
 
@@ -185,18 +281,35 @@ void CvProgramming::pom_feedback(void) {
   // value in the PoM command and the value stored in the decoder. Such behavior is useful for Service 
   // Mode Programming, but not for PoM. However, since we can send information back via the RS-bus, 
   // we modify this behavior and send the byte value stored in the decoder back.
+  #if DCC_CORE_POM_FEEDBACK
+  uint8_t value = readCv(cvCmd.number);
+  rsbusPom.send8bits(value);
+  dccTrace(tracePomAnswer, value, 0);
+  #if DCC_CORE_FEEDBACK
+  rsFeedback.defer();                       // The answer goes before new bulk feedback
+  #endif
+  #endif
+}
+
+
+//*****************************************************************************************************
+// CvProgramming::readCv
+//*****************************************************************************************************
+uint8_t CvProgramming::readCv(unsigned int number) {
   // Note that all CV values can be retrieved from EEPROM, except:
   // - CV23 (Search function which blinks led)
   // - CV26 (DccQuality)
   // - CV31 (ParityErrors)
   // - CV32 (PulseErrors)
-  unsigned int RecCvNumber = cvCmd.number;
-  uint8_t CurrentEEPROMValue = cvValues.read(RecCvNumber);
-  if      (RecCvNumber == Search) rsbusPom.send8bits(LedShouldFlash);
-  else if (RecCvNumber == DccQuality) rsbusPom.send8bits(dcc.errorXOR);
-  else if (RecCvNumber == ParityErrors) rsbusPom.send8bits(rsbusHardware.parityErrors);
-  else if (RecCvNumber == PulseErrors) rsbusPom.send8bits(rsbusHardware.pulseCountErrors);
-  else rsbusPom.send8bits(CurrentEEPROMValue);
+  // - the diagnostic CVs of signalQuality (CV240..CV253)
+  if      (number == Search) return LedShouldFlash;
+  else if (number == DccQuality) return dcc.errorXOR;
+  else if (number == ParityErrors) return rsbusHardware.parityErrors;
+  else if (number == PulseErrors) return rsbusHardware.pulseCountErrors;
+  #if DCC_CORE_QUALITY
+  else if (signalQuality.isDiagnosticCv(number)) return signalQuality.read(number);
+  #endif
+  return cvValues.read(number);
 }
 
 
@@ -204,18 +317,26 @@ void CvProgramming::pom_feedback(void) {
 // CvProgramming::processMessage
 //*****************************************************************************************************
 void CvProgramming::processMessage(Dcc::CmdType_t cmdType) {
+  #if DCC_CORE_CV_PROGRAMMING
   // Create some local variables 
   unsigned int RecCvNumber = cvCmd.number;
   uint8_t RecCvData = cvCmd.value;
-  uint8_t CurrentEEPROMValue = cvValues.read(RecCvNumber);
   bool SM  = (cmdType == Dcc::SmCmd);
   bool PoM = (cmdType == Dcc::MyPomCmd);
+  dccTrace(traceProgCmd, PoM, cvCmd.operation);
   // 2025/05/06 AP: Modified, to allow using the entire EEPROM size
   // Ensure we stay within the range supported by this decoder
   // if (RecCvNumber < max_cvs) {
   // if (RecCvNumber <  EEPROM_SIZE) {
   // 2025/10/18 AP: Modified, since EEPROM_SIZE is not always defined.
-  if (RecCvNumber <= E2END) {
+  // 2026/10/18 AP: E2END is only defined by the AVR headers; otherwise ask the EEPROM library.
+  // 2026/10/18 AP: CV0 does not exist; EEPROM location 0 tells if the EEPROM has been initialised
+  #if defined(E2END)
+  if ((RecCvNumber > 0) && (RecCvNumber <= E2END)) {
+  #else
+  if ((RecCvNumber > 0) && (RecCvNumber < EEPROM.length())) {
+  #endif
+    uint8_t CurrentEEPROMValue = cvValues.read(RecCvNumber);
     switch(cvCmd.operation) {
       case CvAccess::verifyByte :
         if (SM) {
@@ -230,48 +351,13 @@ void CvProgramming::processMessage(Dcc::CmdType_t cmdType) {
         }
       break;
       case CvAccess::writeByte :
-        // A number of CVs have a special meaning, and can not directly be written
-        switch (RecCvNumber) {
-          case version:
-            // CV7 (version): should not be writeable
-          break;
-          case VID: 
-            //CV8 (VID): Reset decoder data to initial values if we'll write to CV8 the value 0x0D
-            if (RecCvData == 0x0D) {
-              cvValues.setDefaults();
-              if (SM) dcc.sendAck();
-              processor.reboot();
-            }
-          break;
-          case Restart:
-            // CV25: Restart the decoder if we write a value of 1 or higher, but do not reset the EEPROM data (cvValues)
-            // Use this function after PoM has changed CV values and new values should take effect now
-            if (RecCvData) processor.reboot();
-          break;
-          case Search:
-            // Search function: blink the decoder's LED if CV23 is set to 1. 
-            // Continue blinking until CV23 is set to 0
-            if (RecCvData) {
-              LedShouldFlash = true; 
-              onBoardLed.flashFast();
-            } 
-            else {
-              LedShouldFlash = false; 
-              onBoardLed.turn_off();
-            }
-          break;
-          default:
-            cvValues.write(RecCvNumber, RecCvData);
-            if (SM) dcc.sendAck();
-          break;
-        }
+        writeCv(RecCvNumber, RecCvData, SM);
       break;
       case CvAccess::bitManipulation :
       // Note: CV Bit Operation is only implemented for Service Mode (not for PoM)
+      // A bit write is handled as a write of the resulting byte, so special CVs are protected
         if (cvCmd.writecmd) {
-          uint8_t NewEEPROMValue = cvCmd.writeBit(CurrentEEPROMValue);
-          cvValues.write(RecCvNumber, NewEEPROMValue);
-          if (SM) dcc.sendAck();
+          writeCv(RecCvNumber, cvCmd.writeBit(CurrentEEPROMValue), SM);
         }
         else { // verify if bits are equal
           if (cvCmd.verifyBit(CurrentEEPROMValue)) {
@@ -283,6 +369,57 @@ void CvProgramming::processMessage(Dcc::CmdType_t cmdType) {
       break;
     }
   }
+  #endif // DCC_CORE_CV_PROGRAMMING
+}
+
+
+//*****************************************************************************************************
+// CvProgramming::writeCv
+//*****************************************************************************************************
+void CvProgramming::writeCv(unsigned int number, uint8_t value, bool SM) {
+  #if DCC_CORE_CV_PROGRAMMING
+  #if DCC_CORE_QUALITY
+  if (signalQuality.isDiagnosticCv(number)) return;   // Read-only
+  #endif
+  // A number of CVs have a special meaning, and can not directly be written
+  switch (number) {
+    case version:
+      // CV7 (version): should not be writeable
+    break;
+    case VID: 
+      //CV8 (VID): Reset decoder data to initial values if we'll write to CV8 the value 0x0D
+      if (value == 0x0D) {
+        cvValues.setDefaults();
+        if (SM) dcc.sendAck();
+        processor.reboot();
+      }
+    break;
+    case Restart:
+      // CV25: Restart the decoder if we write a value of 1 or higher, but do not reset the EEPROM data (cvValues)
+      // Use this function after PoM has changed CV values and new values should take effect now
+      if (value) processor.reboot();
+    break;
+    case Search:
+      // Search function: blink the decoder's LED if CV23 is set to 1. 
+      // Continue blinking until CV23 is set to 0
+      #if DCC_CORE_LED
+      if (value) {
+        LedShouldFlash = true; 
+        onBoardLed.flashFast();
+      } 
+      else {
+        LedShouldFlash = false; 
+        onBoardLed.turn_off();
+      }
+      #endif
+    break;
+    default:
+      cvValues.write(number, value);
+      dccTrace(traceCvWrite, number & 0xFF, value);
+      if (SM) dcc.sendAck();
+    break;
+  }
+  #endif // DCC_CORE_CV_PROGRAMMING
 }
 
 
@@ -291,23 +428,44 @@ void CvProgramming::processMessage(Dcc::CmdType_t cmdType) {
 //*****************************************************************************************************
 void CommonDecHwFunctions::init(void) {
   // Should be called from setup() in the main sketch.
-  // Initialise the EEPROM (cvValues) if it has been erased. 
-  if (cvValues.notInitialised()) cvValues.setDefaults();
-  // attach input pins to the objects below 
+  // The start-up is staged, such that the decoder answers RS-Bus polls as early as possible:
+  // Stage 1: attach the DCC and RS-Bus interfaces
   dcc.attach(dccPin, ackPin);
   rsbusHardware.swapUsartPin = swapUsartPin;
   rsbusHardware.attach(rsBusUsart, rsBusRX);
+  attachTime = millis();
+  answerTime = 0;
+  // Stage 2: initialise the EEPROM (cvValues) if it has been erased. Filling the EEPROM takes
+  // some 200ms, and is therefore done by update(), one byte per call. Till the EEPROM is filled,
+  // cvValues.read() returns the default values, so the steps below and setup() can continue.
+  if (cvValues.notInitialised()) cvValues.startDefaults();
+  _ready = !cvValues.filling();
+  readyTime = attachTime;
+  // Stage 3: attach the other objects. The LED start-up pattern is shown by update()
+  #if DCC_CORE_LED
   onBoardLed.attach(ledPin);
+  #endif
+  #if DCC_CORE_PROG_BUTTON
   progButton.attach(buttonPin);
+  #endif
   // Set the Loco address for PoM messages and the RSBus PoM Feedback address 
+  #if DCC_CORE_CV_PROGRAMMING
   cvProgramming.initPoM();
+  #endif
   // Light the LED to indicate the decoder has started and if the address is set
+  #if DCC_CORE_LED
   onBoardLed.start_up();
   if (cvValues.addressNotSet()) onBoardLed.flashSlow();
   else onBoardLed.start_up();
+  #endif
   // Set the Accessory address and the type of Command Station
   accCmd.setMyAddress(cvValues.storedAddress());
   accCmd.myMaster = cvValues.read(CmdStation);
+  // By default, the address set only contains the address above. The main sketch may extend it
+  decoderAddresses.init(cvValues.storedAddress(), bitRead(cvValues.read(Config), 6));
+  #if DCC_CORE_QUALITY
+  signalQuality.init();
+  #endif
   // initializes the 20ms timer that reduces the CPU load of update()
   TLast = millis();
 }  
@@ -315,13 +473,42 @@ void CommonDecHwFunctions::init(void) {
 
 void CommonDecHwFunctions::update(void) {
   // Should be called from main as often as possible.
-  // checkPolling() is called as often as possible. The  others only every 20ms
+  // checkPolling() and the RS-Bus connections are handled as often as possible. The others only
+  // every 20ms
   rsbusHardware.checkPolling();             // Control and maintain the RS-bus polling cycles  
+  if (!_ready) {
+    _ready = cvValues.fillDefaults();       // Start-up: write the next EEPROM byte
+    if (_ready) readyTime = millis();
+  }
+  #if DCC_CORE_DISPATCH
+  commandDispatcher.update();               // If attached: take and dispatch new DCC commands
+  #endif
   unsigned long TNow = millis();            // millis() is expensive, so call it only once
   if ((TNow - TLast) >= 20) {               // 20ms passed?
     TLast = TNow;
-    rsbusPom.checkConnection();             // Check RS-Bus buffer for address 128 (PoM messages)
+    #if DCC_CORE_FEEDBACK
+    rsFeedback.tick();                      // Queue changes of the feedback state, and repetitions
+    #endif
+    #if DCC_CORE_QUALITY
+    signalQuality.update(TNow);             // Once per second: sample the error counters
+    #endif
+    #if DCC_CORE_PROG_BUTTON
     progButton.checkForNewDecoderAddress(); // Is the decoder programming button pushed?
+    #endif
+    #if DCC_CORE_LED
     onBoardLed.update();                    // Control LED flashing
+    #endif
   }
+  #if DCC_CORE_POM_FEEDBACK
+  rsbusPom.checkConnection();               // Check RS-Bus buffer for address 128 (PoM messages)
+  #endif
+  #if DCC_CORE_FEEDBACK
+  rsFeedback.update();                      // After PoM: feedback requests and RS-Bus buffers
+  #endif
 }                            
+
+
+void CommonDecHwFunctions::feedbackAnswered(void) {
+  // send8bits() only queues the answer; it is transmitted at the next poll of the RS-Bus address
+  if (answerTime == 0) answerTime = millis();
+}
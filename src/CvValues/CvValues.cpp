@@ -8,6 +8,8 @@
 //            2022/08/02 AP Version 1.4 Restructure of the library
 //            2025/03/21 AP Version 1.6 Servo decoder added. EEPROM read / write changed into uint16_t
 //            2025/12/01 AP Version 1.8 Servo-3 and Servo-6 decoders added
+//            2026/10/18 AP Version 1.10 Incremental fill of the EEPROM (startDefaults / fillDefaults)
+//            2026/10/18 AP Version 1.11 eepromWrites counts the EEPROM bytes that changed
 //
 // Purpose:   C++ file that implements the methods to read and modify CV values stored in EEPROM,  
 //            as well as the default values for all CVs.
@@ -114,6 +116,10 @@ void CvValues::init(uint8_t decoderType, uint8_t softwareVersion) {
       // should have its own nibble, thus we need to skip decoder addresses
       // By setting SkipUneven, only Decoder Addresses 2, 4, 6 .... 1024 will be used 
       defaults[SkipUnEven] = 1;         // 0..1
+      // Coil drive
+      // If PwmHold > 0, the coil is not switched off after T_on_Fx, but held with a PWM signal
+      // with this duty cycle (see relayClass::setPwmHold()). 0 keeps the traditional behaviour.
+      defaults[PwmHold] = 0;            // 0..255
       //
     break;
     //
@@ -121,6 +127,7 @@ void CvValues::init(uint8_t decoderType, uint8_t softwareVersion) {
       // The Relays4Decoder uses the same software as the switch decoder, except for some CV values
       defaults[SendFB] = 0;             // No need to send feedback information for relays 
       defaults[AlwaysAct] = 0;          // 0..1 
+      defaults[PwmHold] = 0;            // 0..255
     break;
     //
     case Relays16Decoder:
@@ -281,8 +288,8 @@ bool CvValues::notInitialised(void) {
 
 bool CvValues::addressNotSet(void) {
   // For GBM we check CV10 (RS-Bus address), for others CV9 (decoder address)
-  if (cvValues.isGBM()) {return (EEPROM.read(myRSAddr) == 0x00);}
-  else return (EEPROM.read(myAddrH) == 0x80);
+  if (cvValues.isGBM()) {return (read(myRSAddr) == 0x00);}
+  else return (read(myAddrH) == 0x80);
 }
 
 
@@ -310,7 +317,35 @@ bool CvValues::isGBM(void) {
 void CvValues::setDefaults(void) {
   // Note that defaults[0] contains the value that indicates the EEPROM has been initialised
   // Note also that the decoder type as well as software version will be overwritten.
-  for (uint8_t i = 0; i <= max_cvs; i++) EEPROM.update(i, defaults[i]);
+  // defaults[0] is written last, so after a power loss during the fill the EEPROM is still
+  // seen as not initialised, and will be filled again.
+  _fillNext = 0;
+  for (uint8_t i = 1; i <= max_cvs; i++) update(i, defaults[i]);
+  update(0, defaults[0]);
+}
+
+
+void CvValues::startDefaults(void) {
+  _fillNext = 1;
+}
+
+
+bool CvValues::fillDefaults(void) {
+  // Called from decoderHardware.update(). EEPROM.write() waits till the previous write has
+  // finished, which takes some 3.4ms on traditional ATMega processors. Therefore a byte is only
+  // written if the EEPROM is ready.
+  if (_fillNext == 0) return true;
+  #if defined(eeprom_is_ready)
+    if (!eeprom_is_ready()) return false;
+  #endif
+  if (_fillNext <= max_cvs) {
+    update(_fillNext, defaults[_fillNext]);
+    _fillNext++;
+    return false;
+  }
+  update(0, defaults[0]);
+  _fillNext = 0;
+  return true;
 }
 
 
@@ -318,12 +353,24 @@ void CvValues::setDefaults(void) {
 // Read and Write
 //*****************************************************************************************************
 uint8_t CvValues::read(uint16_t number){
+  // During the fill, the EEPROM may still contain old values
+  if (_fillNext && (number <= max_cvs)) return defaults[number];
   return EEPROM.read(number);
 }
 
 void CvValues::write(uint16_t number, uint8_t value){
   // We do not do any sanity check regarding the value that is entered!
-  EEPROM.update(number, value) ;
+  // The fill would overwrite the new value, so the fill is completed first
+  if (_fillNext && (number <= max_cvs)) while (!fillDefaults());
+  update(number, value);
+}
+
+
+void CvValues::update(uint16_t number, uint8_t value) {
+  // As EEPROM.update(): only bytes that change are written, to save EEPROM write cycles
+  if (EEPROM.read(number) == value) return;
+  EEPROM.write(number, value);
+  eepromWrites++;
 }
 
 
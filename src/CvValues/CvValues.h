@@ -11,6 +11,9 @@
 //            2025/10/04 AP Version 1.7 Servo-3 decoder added
 //            2025/12/01 AP Version 1.8 Servo-6 and TMC16ChannelSwitchDecoder decoders added
 //            2025/12/05 AP Version 1.6 SwitchType added for switches / servos
+//            2026/10/18 AP Version 1.9 PwmHold added for switches / relays
+//            2026/10/18 AP Version 1.10 Incremental fill of the EEPROM (startDefaults / fillDefaults)
+//            2026/10/18 AP Version 1.11 eepromWrites counts the EEPROM bytes that changed
 //
 // Purpose:   Header file that defines the methods to read and modify CV values stored in EEPROM,
 //            as well as the default values for all
@@ -133,6 +136,7 @@ const uint8_t PulseErrors  = 32;   // 0..255 - RS-bus Signal Quality: number of
 const uint8_t SendFB       = 33;   // 0..1   - Decoder will send switch/servo feedback messages via the RS-Bus
 const uint8_t AlwaysAct    = 34;   // 0..1   - If set, decoder will activate coil / relays / servo for each DCC command received
 const uint8_t SwitchType   = 35;   // 0..2   - 0: normal, 1: Weinert DKW with Spurkranzlenkung, 2: Double crossover
+const uint8_t PwmHold      = 36;   // 0..255 - Switch / Relays-4: PWM duty cycle after T_on_Fx (0 = coil off, 255 = full power)
 
 // CV Names - Specific for a Track Occupancy Decoder
 const uint8_t Min_Samples  = 33;   // 0..8   - Number of ON samples before the state is considered stable
@@ -201,11 +205,18 @@ class CvValues {
     // Functions to ensure the EEPROM is being filled
     bool notInitialised(void);                     // Checks if the EEPROM has been initialised
     void setDefaults(void);                        // Fills the decoder with the default values
+    // Fills the EEPROM incrementally: startDefaults() starts the fill, and each call of
+    // fillDefaults() writes a single byte (if the EEPROM is ready). fillDefaults() returns true
+    // once the fill is complete. Till then, read() returns the defaults for CV0..max_cvs.
+    void startDefaults(void);
+    bool fillDefaults(void);
+    bool filling(void) {return (_fillNext != 0);}
 
 
     // Generic CV functions
     uint8_t read(uint16_t number);                 // Can read every byte in EEPROM
     void write(uint16_t number, uint8_t value);    // Can write every byte in EEPROM
+    uint16_t eepromWrites;                         // Number of EEPROM bytes changed (all writes above)
 
 
     unsigned int storedAddress(void);              // From CV1 and CV9 we get the decoder address
@@ -213,5 +224,7 @@ class CvValues {
     bool isGBM(void);                              // Check if this is a GBM decoder (variant)
 
   private:
+    uint8_t _fillNext;                             // Next CV to be filled (0: no fill running)
+    void update(uint16_t number, uint8_t value);   // Writes the byte if it changed, and counts it
 
 };
@@ -0,0 +1,91 @@
+//*****************************************************************************************************
+//
+// File:      DccAddressSet.cpp
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   The set of accessory addresses a decoder listens to
+//
+// The offset of the received address is calculated as an unsigned number, thus addresses below
+// the base become very large, and fail the same (offset < addressWindow) test as addresses above
+// the window.
+// If the set is a range, the rank of an address within the set equals its offset. For a list,
+// the rank is the number of bits in the bitmap below the bit of the address.
+//
+//*****************************************************************************************************
+#include <Arduino.h>
+#include <AP_DCC_library.h>
+#include "CvValues/CvValues.h"
+#include "AP_DccAddressSet.h"
+
+extern Dcc dcc;
+extern Accessory accCmd;
+extern CvValues cvValues;
+
+
+static uint8_t bitCount(uint8_t value) {
+  uint8_t count = 0;
+  while (value) {
+    value &= value - 1;                       // Clears the lowest bit that is set
+    count++;
+  }
+  return count;
+}
+
+
+void DccAddressSet::init(unsigned int base, bool outputAddressing) {
+  _base = base;
+  _outputAddressing = outputAddressing;
+  index = 0;
+  setRange(1);
+}
+
+
+void DccAddressSet::clear(void) {
+  for (uint8_t i = 0; i < (addressWindow / 8); i++) _bitmap[i] = 0;
+  _range = 0;
+}
+
+
+void DccAddressSet::setRange(uint8_t count) {
+  if (count > addressWindow) count = addressWindow;
+  clear();
+  for (uint8_t i = 0; i < count; i++) _bitmap[i >> 3] |= (1 << (i & 7));
+  _range = count;
+}
+
+
+void DccAddressSet::add(uint8_t offset) {
+  if (offset >= addressWindow) return;
+  _bitmap[offset >> 3] |= (1 << (offset & 7));
+  _range = 0;                                 // The set may no longer be a range
+}
+
+
+void DccAddressSet::addFromCvs(uint8_t firstCv, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) add(cvValues.read(firstCv + i));
+}
+
+
+bool DccAddressSet::match(void) {
+  if ((dcc.cmdType != Dcc::MyAccessoryCmd) && (dcc.cmdType != Dcc::AnyAccessoryCmd)) return false;
+  if (_base == 65535) return false;
+  unsigned int address = _outputAddressing ? accCmd.outputAddress : accCmd.decoderAddress;
+  unsigned int offset = address - _base;
+  uint8_t rank;
+  if (_range) {
+    if (offset >= _range) return false;
+    rank = offset;
+  }
+  else {
+    if (offset >= addressWindow) return false;
+    uint8_t byte = offset >> 3;
+    uint8_t mask = 1 << (offset & 7);
+    if (!(_bitmap[byte] & mask)) return false;
+    rank = bitCount(_bitmap[byte] & (mask - 1));
+    for (uint8_t i = 0; i < byte; i++) rank += bitCount(_bitmap[i]);
+  }
+  if (_outputAddressing) index = rank;
+  else index = (rank << 2) + accCmd.turnout - 1;
+  return true;
+}
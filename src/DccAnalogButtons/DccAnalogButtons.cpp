@@ -0,0 +1,163 @@
+//*******************************************************************************************
+//
+// file:      DccAnalogButtons.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0   Initial version
+//            2026-10-18 V1.1   ADC multiplexer saved and restored
+//
+// purpose:   Reads several buttons that are connected via a resistor ladder to a single
+//            analog (ADC) input pin.
+//
+// The ADC is accessed directly, to be able to start a conversion without waiting for the
+// result. The register layout differs between the traditional ATMega processors (ADCSRA, ADMUX)
+// and the newer MegaAVR and DA/DB processors (ADC0.COMMAND, ADC0.MUXPOS). For other
+// architectures the (blocking) analogRead() is used.
+//
+// In all cases a 10 bit result is assumed, of which the 8 most significant bits are used.
+//
+//*******************************************************************************************
+#include "AP_DccAnalogButtons.h"
+
+//*******************************************************************************************
+// Hardware specific functions
+//*******************************************************************************************
+#if defined(ADCSRA)
+// Traditional ATMega processors (16, 328, 2560)
+void DccAnalogButtons::startConversion() {
+  _savedMux = ADMUX;
+  ADMUX = _mux;
+  #if defined(MUX5)
+    _savedMuxB = ADCSRB;
+    ADCSRB = (ADCSRB & ~(1 << MUX5)) | _muxB;
+  #endif
+  ADCSRA |= (1 << ADSC);
+}
+
+bool DccAnalogButtons::conversionReady() {
+  if (ADCSRA & (1 << ADSC)) return false;
+  _value = ADC >> 2;
+  ADMUX = _savedMux;
+  #if defined(MUX5)
+    ADCSRB = _savedMuxB;
+  #endif
+  return true;
+}
+
+#elif defined(ADC0)
+// MegaAVR (4808, 4809) and DA/DB processors
+void DccAnalogButtons::startConversion() {
+  _savedMux = ADC0.MUXPOS;
+  ADC0.MUXPOS = _mux;
+  ADC0.COMMAND = ADC_STCONV_bm;
+}
+
+bool DccAnalogButtons::conversionReady() {
+  if (ADC0.COMMAND & ADC_STCONV_bm) return false;
+  _value = ADC0.RES >> 2;
+  ADC0.MUXPOS = _savedMux;
+  return true;
+}
+
+#else
+// Other architectures: use the (blocking) Arduino analogRead()
+void DccAnalogButtons::startConversion() {
+}
+
+bool DccAnalogButtons::conversionReady() {
+  _value = analogRead(_pin) >> 2;
+  return true;
+}
+#endif
+
+
+//*******************************************************************************************
+// attach and initialise
+//*******************************************************************************************
+void DccAnalogButtons::attach(uint8_t pin, const uint8_t *limits, uint8_t count, uint8_t dbSamples) {
+  _limits = limits;
+  _count = count;
+  _dbSamples = dbSamples;
+  _pin = pin;
+  // A single analogRead() lets the Arduino core configure the ADC (reference, prescaler)
+  // and the multiplexer for this pin. We store the multiplexer setting for later use.
+  _value = analogRead(pin) >> 2;
+  #if defined(ADCSRA)
+    _mux = ADMUX;
+    #if defined(MUX5)
+      _muxB = ADCSRB & (1 << MUX5);
+    #endif
+  #elif defined(ADC0)
+    _mux = ADC0.MUXPOS;
+  #endif
+  _current = classify(_value);
+  _previous = _current;
+  _candidate = _current;
+  _equalSamples = 0;
+  _changed = false;
+  _converting = false;
+  _lastChange = millis();
+  _lastSample = _lastChange;
+}
+
+
+uint8_t DccAnalogButtons::classify(uint8_t value) {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (value <= _limits[i]) return i;
+  }
+  return noAnalogButton;
+}
+
+
+//*******************************************************************************************
+// read(): collect the last result and start the next conversion
+//*******************************************************************************************
+void DccAnalogButtons::read() {
+  _changed = false;
+  if (_converting) {
+    if (!conversionReady()) return;
+    _converting = false;
+    uint8_t sample = classify(_value);
+    if (sample != _candidate) {
+      _candidate = sample;
+      _equalSamples = 1;
+    }
+    else if (_equalSamples < _dbSamples) _equalSamples++;
+    if ((_equalSamples >= _dbSamples) && (_candidate != _current)) {
+      _previous = _current;
+      _current = _candidate;
+      _changed = true;
+      _lastChange = millis();
+    }
+    return;
+  }
+  uint8_t now = millis();
+  if ((uint8_t)(now - _lastSample) >= 5) {
+    _lastSample = now;
+    startConversion();
+    _converting = true;
+  }
+}
+
+
+//*******************************************************************************************
+// Per button functions
+//*******************************************************************************************
+bool DccAnalogButtons::isPressed(uint8_t button) {
+  return (_current == button);
+}
+
+bool DccAnalogButtons::isReleased(uint8_t button) {
+  return (_current != button);
+}
+
+bool DccAnalogButtons::wasPressed(uint8_t button) {
+  return _changed && (_current == button);
+}
+
+bool DccAnalogButtons::wasReleased(uint8_t button) {
+  return _changed && (_previous == button);
+}
+
+bool DccAnalogButtons::pressedFor(uint8_t button, unsigned long ms) {
+  return (_current == button) && (millis() - _lastChange >= ms);
+}
@@ -0,0 +1,191 @@
+//*******************************************************************************************
+//
+// file:      DccButtonBank.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0   Initial version
+//
+// purpose:   Reads and debounces a bank of buttons that are connected to one or more
+//            (8 bit) input ports.
+//
+// Debouncing is performed with vertical counters. A vertical counter stores bit n of the
+// counter for all 8 buttons of a port in a single byte. Therefore the counters of all buttons
+// of a port can be updated in parallel with a handful of logical operations, instead of one
+// counter (and millis() call) per button. The debounce algorithm is the well known algorithm
+// from Peter Dannegger:
+//
+//   changed = state ^ sample;                // which buttons differ from the debounced state?
+//   cnt0 = ~(cnt0 & changed);                // reset (to 11) or count down cnt0
+//   cnt1 = cnt0 ^ (cnt1 & changed);          // reset (to 11) or count down cnt1
+//   changed &= cnt0 & cnt1;                  // counter rolled over (after 4 samples)?
+//   state ^= changed;                        // then toggle the debounced state
+//
+// A button therefore only changes state after 4 consecutive samples that all differ from
+// the current debounced state. Any sample that equals the debounced state resets the counter.
+//
+// The long press counter is a 4 bit vertical counter per button, that counts up (and
+// saturates at 15) while a button is pressed, and is reset as soon as the button is released.
+//
+//*******************************************************************************************
+#include "AP_DccButtonBank.h"
+
+
+//*******************************************************************************************
+// attach and initialize a button of the bank
+//*******************************************************************************************
+bool DccButtonBank::attach(uint8_t pin, bool puEnable, bool invert) {
+  if (buttons >= maxBankButtons) return false;
+  uint8_t port = digitalPinToPort(pin);
+  uint8_t bit = digitalPinToBitMask(pin);
+  // Is this port already in use by another button of this bank?
+  uint8_t index = 0;
+  while ((index < ports) && (portNumber[index] != port)) index++;
+  if (index == ports) {
+    if (ports >= maxBankPorts) return false;
+    bankPort_t &newPort = bank[index];
+    portNumber[index] = port;
+    newPort.portRegister = portInputRegister(port);
+    newPort.mask = 0;
+    newPort.invert = 0;
+    newPort.state = 0;
+    newPort.cnt0 = 0xFF;
+    newPort.cnt1 = 0xFF;
+    newPort.hold0 = newPort.hold1 = newPort.hold2 = newPort.hold3 = 0;
+    newPort.pressed = newPort.released = newPort.longPressed = 0;
+    ports++;
+  }
+  pinMode(pin, puEnable ? INPUT_PULLUP : INPUT);
+  bankPort_t &p = bank[index];
+  p.mask |= bit;
+  if (invert) p.invert |= bit;
+  // Start with the current (not debounced) state of the button, to avoid a wasPressed()
+  // event for buttons that are pressed while the decoder starts.
+  p.state = (*p.portRegister ^ p.invert) & p.mask;
+  // Store the port index and the bit number, to quickly find the button later
+  uint8_t bitNr = 0;
+  while ((bit >> bitNr) > 1) bitNr++;
+  map[buttons] = (index << 4) | bitNr;
+  buttons++;
+  lastScan = millis();
+  lastHold = lastScan;
+  return true;
+}
+
+
+void DccButtonBank::setTimes(uint8_t scan, uint16_t longTime) {
+  if (scan > 0) scanTime = scan;
+  uint16_t tick = longTime / 15;
+  if (tick > 255) tick = 255;
+  if (tick == 0) tick = 1;
+  holdTick = tick;
+}
+
+
+//*******************************************************************************************
+// read() samples all ports, but only if scanTime has passed.
+// Edges from the previous sample are cleared at the next call of read(), similar to the
+// wasPressed() / wasReleased() behaviour of DccButton.
+//*******************************************************************************************
+void DccButtonBank::read() {
+  if (edges) {
+    for (uint8_t i = 0; i < ports; i++) {
+      bank[i].pressed = 0;
+      bank[i].released = 0;
+      bank[i].longPressed = 0;
+    }
+    edges = false;
+  }
+  // Only the lower byte of millis() is needed, since the intervals are below 256ms
+  uint8_t now = millis();
+  bool sample = ((uint8_t)(now - lastScan) >= scanTime);
+  bool hold = ((uint8_t)(now - lastHold) >= holdTick);
+  if (!sample && !hold) return;
+  if (sample) lastScan = now;
+  if (hold) lastHold = now;
+  for (uint8_t i = 0; i < ports; i++) {
+    bankPort_t &p = bank[i];
+    if (sample) {
+      uint8_t changed = p.state ^ ((*p.portRegister ^ p.invert) & p.mask);
+      p.cnt0 = ~(p.cnt0 & changed);
+      p.cnt1 = p.cnt0 ^ (p.cnt1 & changed);
+      changed &= p.cnt0 & p.cnt1;
+      p.state ^= changed;
+      p.pressed = p.state & changed;
+      p.released = ~p.state & changed;
+      if (changed) edges = true;
+    }
+    // Long press counter: reset for all released buttons, count up for pressed buttons
+    uint8_t saturated = p.hold0 & p.hold1 & p.hold2 & p.hold3;
+    if (hold) {
+      uint8_t carry = p.state & ~saturated;
+      p.hold0 ^= carry; carry &= ~p.hold0;
+      p.hold1 ^= carry; carry &= ~p.hold1;
+      p.hold2 ^= carry; carry &= ~p.hold2;
+      p.hold3 ^= carry;
+    }
+    p.hold0 &= p.state;
+    p.hold1 &= p.state;
+    p.hold2 &= p.state;
+    p.hold3 &= p.state;
+    p.longPressed = (p.hold0 & p.hold1 & p.hold2 & p.hold3) & ~saturated;
+    if (p.longPressed) edges = true;
+  }
+}
+
+
+//*******************************************************************************************
+// Per button functions
+//*******************************************************************************************
+bool DccButtonBank::isPressed(uint8_t button) {
+  if (button >= buttons) return false;
+  return bank[map[button] >> 4].state & (1 << (map[button] & 0x07));
+}
+
+bool DccButtonBank::isReleased(uint8_t button) {
+  if (button >= buttons) return false;
+  return !isPressed(button);
+}
+
+bool DccButtonBank::wasPressed(uint8_t button) {
+  if (button >= buttons) return false;
+  return bank[map[button] >> 4].pressed & (1 << (map[button] & 0x07));
+}
+
+bool DccButtonBank::wasReleased(uint8_t button) {
+  if (button >= buttons) return false;
+  return bank[map[button] >> 4].released & (1 << (map[button] & 0x07));
+}
+
+bool DccButtonBank::isLongPressed(uint8_t button) {
+  if (button >= buttons) return false;
+  bankPort_t &p = bank[map[button] >> 4];
+  return (p.hold0 & p.hold1 & p.hold2 & p.hold3) & (1 << (map[button] & 0x07));
+}
+
+bool DccButtonBank::wasLongPressed(uint8_t button) {
+  if (button >= buttons) return false;
+  return bank[map[button] >> 4].longPressed & (1 << (map[button] & 0x07));
+}
+
+
+//*******************************************************************************************
+// Per port functions
+//*******************************************************************************************
+uint8_t DccButtonBank::pressedMask(uint8_t portIndex) {
+  if (portIndex >= ports) return 0;
+  return bank[portIndex].state;
+}
+
+uint8_t DccButtonBank::pressedEdges(uint8_t portIndex) {
+  if (portIndex >= ports) return 0;
+  return bank[portIndex].pressed;
+}
+
+uint8_t DccButtonBank::releasedEdges(uint8_t portIndex) {
+  if (portIndex >= ports) return 0;
+  return bank[portIndex].released;
+}
+
+uint8_t DccButtonBank::longEdges(uint8_t portIndex) {
+  if (portIndex >= ports) return 0;
+  return bank[portIndex].longPressed;
+}
@@ -0,0 +1,82 @@
+//******************************************************************************************************
+//
+// file:      DccCoilScheduler.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Limits the number of relay / switch coils that are active at the same time.
+//
+// The queue is a small array in order of arrival. In FIFO order the first entry is granted; in
+// priority order the first entry with the highest priority. Since the queue is short, removing
+// an entry by shifting the remaining entries is cheap.
+//
+// A relay that is granted may no longer need its coil (if in the meantime it was commanded back to
+// its current position). In that case grant() returns false, and the next relay is tried.
+//
+// request() immediately tries to grant, so that a relay can be activated without waiting for the
+// next call of update() if the power budget allows.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include "AP_DccCoilScheduler.h"
+
+
+void DccCoilScheduler::attach(uint8_t maxActive, uint16_t recharge, order_t order) {
+  _maxActive = (maxActive > 0) ? maxActive : 1;
+  _recharge = recharge;
+  _order = order;
+  _waiting = 0;
+  _active = 0;
+  _lastRelease = millis() - recharge;
+}
+
+
+bool DccCoilScheduler::request(relayClass *relay, uint8_t prio) {
+  if (_waiting >= maxCoilRequests) return false;
+  _queue[_waiting] = relay;
+  _prio[_waiting] = prio;
+  _waiting++;
+  update();
+  return true;
+}
+
+
+void DccCoilScheduler::remove(uint8_t index) {
+  _waiting--;
+  for (uint8_t i = index; i < _waiting; i++) {
+    _queue[i] = _queue[i + 1];
+    _prio[i] = _prio[i + 1];
+  }
+}
+
+
+void DccCoilScheduler::cancel(relayClass *relay) {
+  for (uint8_t i = 0; i < _waiting; i++) {
+    if (_queue[i] == relay) {
+      remove(i);
+      return;
+    }
+  }
+}
+
+
+void DccCoilScheduler::release() {
+  if (_active > 0) _active--;
+  _lastRelease = millis();
+}
+
+
+void DccCoilScheduler::update() {
+  while ((_waiting > 0) && (_active < _maxActive)) {
+    if ((_recharge > 0) && (millis() - _lastRelease < _recharge)) return;
+    uint8_t next = 0;
+    if (_order == priority) {
+      for (uint8_t i = 1; i < _waiting; i++) {
+        if (_prio[i] > _prio[next]) next = i;
+      }
+    }
+    relayClass *relay = _queue[next];
+    remove(next);
+    if (relay->grant()) _active++;
+  }
+}
@@ -0,0 +1,153 @@
+//*****************************************************************************************************
+//
+// File:      DccCvSerial.cpp
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//            2026/10/18 AP Version 1.1 CVs are read with cvProgramming.readCv(), as for PoM feedback
+//
+// Purpose:   Reads and writes blocks of CVs via a serial port
+//
+// _frame holds the frame without the sync byte: cmd, CV low, CV high, len, data, CRC low, CRC high.
+// The same buffer is used for the answer, which is prepared in place (including the sync byte)
+// and sent once the UART has room for the complete answer.
+//
+// update() is a small state machine:
+// - waitSync:  bytes are skipped till the sync byte is received
+// - receiving: bytes are stored till the frame is complete; then the frame is checked
+// - writing:   one CV of a write block is written per call
+// - answering: waits till the answer fits in the transmit buffer
+//
+//*****************************************************************************************************
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "AP_DCC_Decoder_Core.h"
+#include "AP_DccCvSerial.h"
+
+#define cvSync          0x7E
+#define cvHeaderSize    4           // cmd, CV low, CV high, len
+#define cvTimeout       100         // ms
+
+
+uint16_t DccCvSerial::crc16(const uint8_t *data, uint8_t length) {
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      if (crc & 0x8000) crc = (crc << 1) ^ 0x1021;
+      else crc <<= 1;
+    }
+  }
+  return crc;
+}
+
+
+void DccCvSerial::attach(Stream &port) {
+  _port = &port;
+  _state = waitSync;
+}
+
+
+uint8_t DccCvSerial::dataLength(void) {
+  // Only a write block command carries data; a read block command only gives the number of CVs
+  return (_frame[0] == 'W') ? _frame[3] : 0;
+}
+
+
+void DccCvSerial::answer(uint8_t cmd, uint8_t len) {
+  // The CV number is still in _frame[2..3], the data (if any) is already in place
+  // The answer is shifted one byte, to make room for the sync byte
+  memmove(&_frame[1 + cvHeaderSize], &_frame[cvHeaderSize], len);
+  _frame[3] = _frame[2];
+  _frame[2] = _frame[1];
+  _frame[1] = cmd;
+  _frame[4] = len;
+  _frame[0] = cvSync;
+  uint16_t crc = crc16(&_frame[1], cvHeaderSize + len);
+  _frame[1 + cvHeaderSize + len] = crc & 0xFF;
+  _frame[2 + cvHeaderSize + len] = crc >> 8;
+  _state = answering;
+}
+
+
+void DccCvSerial::error(uint8_t code) {
+  _frame[cvHeaderSize] = code;
+  answer('e', 1);
+}
+
+
+void DccCvSerial::process(void) {
+  uint8_t cmd = _frame[0];
+  unsigned int first = _frame[1] | (_frame[2] << 8);
+  uint8_t len = _frame[3];
+  uint8_t data = dataLength();
+  uint16_t crc = _frame[cvHeaderSize + data] | (_frame[cvHeaderSize + data + 1] << 8);
+  if (crc != crc16(_frame, cvHeaderSize + data)) {error(cvErrorCrc); return;}
+  if ((len == 0) || (len > cvBlockSize)) {error(cvErrorLength); return;}
+  // The same range as accepted by processMessage()
+  #if defined(E2END)
+  if ((first == 0) || (first + len - 1 > E2END)) {error(cvErrorRange); return;}
+  #else
+  if ((first == 0) || (first + len > EEPROM.length())) {error(cvErrorRange); return;}
+  #endif
+  switch (cmd) {
+    case 'R':
+      for (uint8_t i = 0; i < len; i++) _frame[cvHeaderSize + i] = cvProgramming.readCv(first + i);
+      answer('r', len);
+    break;
+    case 'W':
+      _next = 0;
+      _state = writing;
+    break;
+    default:
+      error(cvErrorCommand);
+    break;
+  }
+}
+
+
+void DccCvSerial::update(void) {
+  if (_port == nullptr) return;
+  switch (_state) {
+    case waitSync:
+    case receiving:
+      if ((_state == receiving) && (millis() - _lastByte > cvTimeout)) _state = waitSync;
+      while (_port->available()) {
+        uint8_t c = _port->read();
+        _lastByte = millis();
+        if (_state == waitSync) {
+          if (c == cvSync) {
+            _state = receiving;
+            _received = 0;
+          }
+          continue;
+        }
+        _frame[_received++] = c;
+        if (_received < cvHeaderSize) continue;
+        if (_frame[3] > cvBlockSize) {error(cvErrorLength); return;}
+        if (_received == cvHeaderSize + dataLength() + 2) {
+          process();
+          return;                         // The remaining bytes are handled by the next calls
+        }
+      }
+    break;
+    case writing: {
+      // One CV per call. Unchanged CVs are skipped, so their side effects are not repeated
+      #if defined(eeprom_is_ready)
+        if (!eeprom_is_ready()) return;
+      #endif
+      unsigned int number = (_frame[1] | (_frame[2] << 8)) + _next;
+      uint8_t value = _frame[cvHeaderSize + _next];
+      if (cvValues.read(number) != value) cvProgramming.writeCv(number, value);
+      _next++;
+      if (_next == _frame[3]) answer('w', 0);
+    }
+    break;
+    case answering: {
+      uint8_t size = 1 + cvHeaderSize + _frame[4] + 2;
+      if (_port->availableForWrite() < size) return;
+      _port->write(_frame, size);
+      _state = waitSync;
+    }
+    break;
+  }
+}
@@ -0,0 +1,78 @@
+//*****************************************************************************************************
+//
+// File:      DccDispatcher.cpp
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   Table driven dispatch of accessory commands to handlers per output
+//
+// decoderAddresses.match() translates the address of an accessory command into the output index,
+// which selects the slot in the table. The handler is therefore found with a single indexed
+// lookup, whatever the number of outputs.
+//
+//*****************************************************************************************************
+#include "AP_DCC_Decoder_Core.h"
+#include "AP_DccDispatcher.h"
+
+
+void DccDispatcher::attach(DccOutputSlot *slots, uint8_t count) {
+  _slots = slots;
+  _count = count;
+  clearCounters();
+}
+
+
+void DccDispatcher::set(uint8_t index, accHandler_t basic, accHandler_t extended) {
+  if (index >= _count) return;
+  _slots[index].basic = basic;
+  _slots[index].extended = extended;
+}
+
+
+uint16_t DccDispatcher::commands(uint8_t index) {
+  if (index >= _count) return 0;
+  return _slots[index].commands;
+}
+
+
+void DccDispatcher::clearCounters(void) {
+  for (uint8_t i = 0; i < _count; i++) _slots[i].commands = 0;
+}
+
+
+void DccDispatcher::update(void) {
+  if (_count == 0) return;
+  // Commands that arrive in a burst (such as a route) are handled within the same update()
+  for (uint8_t i = 0; i < dispatchBurst; i++) {
+    if (!dcc.input()) return;
+    dispatch();
+  }
+}
+
+
+void DccDispatcher::dispatch(void) {
+  switch (dcc.cmdType) {
+    case Dcc::MyAccessoryCmd :
+    case Dcc::AnyAccessoryCmd :
+      if (decoderAddresses.match() && (decoderAddresses.index < _count)) {
+        DccOutputSlot &slot = _slots[decoderAddresses.index];
+        slot.commands++;
+        if (accCmd.command == Accessory::basic) {
+          if (slot.basic) slot.basic(decoderAddresses.index, accCmd.position, accCmd.activate);
+        }
+        else {
+          if (slot.extended) slot.extended(decoderAddresses.index, accCmd.position, true);
+        }
+      }
+    break;
+    #if DCC_CORE_CV_PROGRAMMING
+    case Dcc::MyPomCmd :
+    case Dcc::SmCmd :
+      cvProgramming.processMessage(dcc.cmdType);
+    break;
+    #endif
+    default:
+      if (_other) _other(dcc.cmdType);
+    break;
+  }
+}
@@ -0,0 +1,97 @@
+//*****************************************************************************************************
+//
+// File:      DccFeedback.cpp
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//            2026/10/18 AP Version 1.1 Feedback requests are answered on every update() call
+//
+// Purpose:   Change driven RS-Bus feedback for one or more consecutive RS-Bus addresses
+//
+// The RSbusConnection FIFO of a slot receives new data only after the window has passed, so the
+// FIFO holds at most a few updates per address, instead of every intermediate state.
+// decoderHardware.update() calls rsbusPom.checkConnection() before update(), which gives PoM
+// answers the first chance to use the RS-Bus. Only the window and repetition bookkeeping in tick()
+// runs at the 20ms pace; feedback requests are answered as fast as a sketch that polls its own
+// RSbusConnection objects.
+//
+//*****************************************************************************************************
+#include "AP_DCC_Decoder_Core.h"
+#include "AP_DccFeedback.h"
+
+
+void DccFeedback::attach(DccFeedbackSlot *slots, uint8_t count, uint8_t firstAddress, uint8_t window) {
+  _slots = slots;
+  _count = count;
+  _window = (window + feedbackTick - 1) / feedbackTick;
+  _fec = cvValues.read(RSFEC);
+  if (_fec > 2) _fec = 2;
+  _deferred = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    DccFeedbackSlot &slot = _slots[i];
+    slot.connection.address = firstAddress + i;
+    slot.current = 0;
+    slot.sent = 0;
+    slot.wait = 0;
+    slot.repeats = 0;
+  }
+}
+
+
+void DccFeedback::set(uint8_t slot, uint8_t value) {
+  if (slot >= _count) return;
+  _slots[slot].current = value;
+}
+
+
+void DccFeedback::setBit(uint8_t output, bool value) {
+  uint8_t slot = output >> 3;
+  if (slot >= _count) return;
+  if (value) _slots[slot].current |= (1 << (output & 7));
+  else _slots[slot].current &= ~(1 << (output & 7));
+}
+
+
+uint8_t DccFeedback::value(uint8_t slot) {
+  if (slot >= _count) return 0;
+  return _slots[slot].current;
+}
+
+
+void DccFeedback::send(DccFeedbackSlot &slot) {
+  slot.connection.send8bits(slot.current);
+  slot.sent = slot.current;
+  slot.wait = _window;
+}
+
+
+void DccFeedback::update(void) {
+  for (uint8_t i = 0; i < _count; i++) {
+    DccFeedbackSlot &slot = _slots[i];
+    if (slot.connection.feedbackRequested) {
+      send(slot);                                 // The master station wants the complete state
+      slot.repeats = 0;
+      decoderHardware.feedbackAnswered();         // Start-up metric
+    }
+    slot.connection.checkConnection();
+  }
+}
+
+
+void DccFeedback::tick(void) {
+  if (_count == 0) return;
+  if (_deferred) _deferred--;
+  for (uint8_t i = 0; i < _count; i++) {
+    DccFeedbackSlot &slot = _slots[i];
+    if (slot.wait) slot.wait--;
+    if ((slot.wait == 0) && (_deferred == 0)) {
+      if (slot.current != slot.sent) {
+        send(slot);
+        slot.repeats = _fec;
+      }
+      else if (slot.repeats) {
+        send(slot);
+        slot.repeats--;
+      }
+    }
+  }
+}
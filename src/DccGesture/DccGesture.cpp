@@ -0,0 +1,78 @@
+//*******************************************************************************************
+//
+// file:      DccGesture.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0   Initial version
+//
+// purpose:   Recognises gestures on a (debounced) DccButton
+//
+// All timing is derived from the DccButton object: pressedFor() and releasedFor() measure the
+// time since the last debounced state change. The recogniser itself therefore needs no timers
+// and only four bytes of state (plus the configured times).
+//
+//*******************************************************************************************
+#include "AP_DccGesture.h"
+
+
+void DccGesture::attach(DccButton *button) {
+  _button = button;
+  _state = waitFree;
+  _clicks = 0;
+  _level = 0;
+}
+
+
+void DccGesture::setTimes(uint16_t clickGap, uint16_t holdTime1, uint16_t holdTime2, uint16_t holdTime3) {
+  _clickGap = clickGap;
+  _holdTime[0] = holdTime1;
+  _holdTime[1] = holdTime2;
+  _holdTime[2] = holdTime3;
+}
+
+
+DccGesture::gesture_t DccGesture::update(void) {
+  _button->read();
+  switch (_state) {
+    case waitFree:
+      if (_button->isReleased()) _state = idle;
+    break;
+    case idle:
+      if (_button->wasPressed()) {
+        _clicks = 1;
+        _state = pressed;
+      }
+    break;
+    case pressed:
+      if (_button->wasReleased()) _state = released;
+      else if (_holdTime[0] && _button->pressedFor(_holdTime[0])) {
+        _level = 1;
+        _state = holding;
+        return hold1;
+      }
+    break;
+    case released:
+      if (_button->wasPressed()) {
+        _clicks++;
+        _state = pressed;
+      }
+      else if ((_clicks >= 3) || _button->releasedFor(_clickGap)) {
+        _state = idle;
+        if (_clicks == 1) return click1;
+        if (_clicks == 2) return click2;
+        return click3;
+      }
+    break;
+    case holding:
+      if (_button->wasReleased()) {
+        _state = idle;
+        return holdEnd;
+      }
+      if ((_level < 3) && _holdTime[_level] && _button->pressedFor(_holdTime[_level])) {
+        _level++;
+        if (_level == 2) return hold2;
+        return hold3;
+      }
+    break;
+  }
+  return none;
+}
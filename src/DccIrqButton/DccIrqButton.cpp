@@ -0,0 +1,159 @@
+//*******************************************************************************************
+//
+// file:      DccIrqButton.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0   Initial version
+//            2026-10-18 V1.1   32 bit time of the last state change
+//            2026-10-18 V1.2   All irqQueueSize queue entries are used
+//
+// purpose:   Interrupt driven (debounced) buttons
+//
+// attachInterrupt() only accepts functions without parameters. Therefore a small table of
+// "trampoline" functions is used, one per button, that call the isr() method of the
+// corresponding object.
+//
+// Debouncing is "leading edge": the first edge that changes the state is accepted immediately,
+// after which all edges within the debounce time are ignored. Once no edges have been seen for
+// at least the debounce time, the pin is read once more to ensure the debounced state equals
+// the real state (for example if the queue did overflow, or the last bounce was ignored).
+//
+//*******************************************************************************************
+#include "AP_DccIrqButton.h"
+
+static DccIrqButton *irqButtons[maxIrqButtons];
+static uint8_t numberOfIrqButtons = 0;
+
+static void irqButton0(void) {irqButtons[0]->isr();}
+static void irqButton1(void) {irqButtons[1]->isr();}
+static void irqButton2(void) {irqButtons[2]->isr();}
+static void irqButton3(void) {irqButtons[3]->isr();}
+
+static void (*const trampolines[maxIrqButtons])(void) = {
+  irqButton0, irqButton1, irqButton2, irqButton3
+};
+
+
+//*******************************************************************************************
+// attach and initialize a DccIrqButton object and the pin it's connected to.
+//*******************************************************************************************
+bool DccIrqButton::attach(uint8_t pin, uint8_t dbTime, bool puEnable, bool invert) {
+  int irq = digitalPinToInterrupt(pin);
+  if (irq == NOT_AN_INTERRUPT) return false;
+  if (numberOfIrqButtons >= maxIrqButtons) return false;
+  m_dbTime = dbTime;
+  m_invert = invert;
+  pinMode(pin, puEnable ? INPUT_PULLUP : INPUT);
+  m_bit = digitalPinToBitMask(pin);
+  m_portRegister = portInputRegister(digitalPinToPort(pin));
+  m_state = (*m_portRegister & m_bit);
+  if (m_invert) m_state = !m_state;
+  m_lastChange = millis();
+  m_lastEdge = (uint16_t)m_lastChange;
+  m_settle = false;
+  m_pressCount = 0;
+  m_releaseCount = 0;
+  m_head = 0;
+  m_tail = 0;
+  m_overflow = false;
+  irqButtons[numberOfIrqButtons] = this;
+  attachInterrupt(irq, trampolines[numberOfIrqButtons], CHANGE);
+  numberOfIrqButtons++;
+  return true;
+}
+
+
+//*******************************************************************************************
+// The interrupt service routine. Only stores the time and level of the edge.
+//*******************************************************************************************
+void DccIrqButton::isr() {
+  uint16_t now = millis();
+  m_lastEdge = now;
+  uint8_t head = m_head;
+  if ((uint8_t)(head - m_tail) >= irqQueueSize) {   // queue is full
+    m_overflow = true;
+    return;
+  }
+  uint8_t entry = head & (irqQueueSize - 1);
+  m_edgeTime[entry] = now;
+  if (*m_portRegister & m_bit) m_levels |= (1 << entry);
+  else m_levels &= ~(1 << entry);
+  m_head = head + 1;
+}
+
+
+//*******************************************************************************************
+// read() processes all queued edges. It does not need to be called from the main loop, since
+// the query functions below call read() themselves.
+//*******************************************************************************************
+void DccIrqButton::accept(bool level, unsigned long time) {
+  m_state = level;
+  m_lastChange = time;
+  if (m_state) m_pressCount++;
+  else m_releaseCount++;
+}
+
+
+bool DccIrqButton::read() {
+  // Fast path: nothing happened since the previous call
+  if ((m_tail == m_head) && !m_settle && !m_overflow) return m_state;
+  unsigned long now = millis();
+  while (m_tail != m_head) {
+    uint8_t entry = m_tail & (irqQueueSize - 1);
+    // The 16 bit edge time is converted into a full millis() value, via its age
+    unsigned long time = now - (uint16_t)((uint16_t)now - m_edgeTime[entry]);
+    bool level = (m_levels >> entry) & 1;
+    if (m_invert) level = !level;
+    if ((level != m_state) && ((time - m_lastChange) >= m_dbTime)) accept(level, time);
+    m_tail++;
+    m_settle = true;
+  }
+  if (m_overflow) {
+    m_overflow = false;
+    m_settle = true;
+  }
+  // After the bouncing has stopped, check if the real pin level equals the debounced state
+  noInterrupts();
+  uint16_t lastEdge = m_lastEdge;       // 16 bit value that is modified by the ISR
+  interrupts();
+  if (m_settle && ((uint16_t)((uint16_t)now - lastEdge) >= m_dbTime)) {
+    m_settle = false;
+    bool level = (*m_portRegister & m_bit);
+    if (m_invert) level = !level;
+    if (level != m_state) accept(level, now);
+  }
+  return m_state;
+}
+
+
+//*******************************************************************************************
+// Query functions
+//*******************************************************************************************
+bool DccIrqButton::isPressed() {
+  return read();
+}
+
+bool DccIrqButton::isReleased() {
+  return !read();
+}
+
+bool DccIrqButton::wasPressed() {
+  read();
+  if (m_pressCount == 0) return false;
+  m_pressCount--;
+  return true;
+}
+
+bool DccIrqButton::wasReleased() {
+  read();
+  if (m_releaseCount == 0) return false;
+  m_releaseCount--;
+  return true;
+}
+
+bool DccIrqButton::pressedFor(unsigned long ms) {
+  return read() && ((millis() - m_lastChange) >= ms);
+}
+
+bool DccIrqButton::releasedFor(unsigned long ms) {
+  return !read() && ((millis() - m_lastChange) >= ms);
+}
@@ -6,12 +6,13 @@
 //            2021-06-15 V1.1   ap attach/detach for pins (instead of constructor)
 //            2021-06-26 V1.2   ap extended with fade out
 //            2022-07-20 V1.3   ap divided into multiple objects, to save RAM if methods are not needed
+//            2026-10-18 V1.4   ap direct port access (DccFastPin) instead of digitalWrite()
 //
 // purpose:   Functions related to LEDs
 //
 // Object inheritance (between brackets the required RAM)
-// BasicLed (2) +--> FlashLed (11) ---> DCCLed (11)
-//              +--> FadeOutLed (23)
+// BasicLed (4) +--> FlashLed (13) ---> DCCLed (13)
+//              +--> FadeOutLed (25)
 //
 //******************************************************************************************************
 #include <Arduino.h>
@@ -22,23 +23,22 @@
 // BasicLed: Simple on/off LEDs
 //******************************************************************************************************
 void BasicLed::attach(uint8_t pin, bool invert){
-  _pin = pin;
-  pinMode(_pin, OUTPUT);
+  _pin.attach(pin);
   if (invert) _LED_ON = LOW;                // In some cases the LED goes ON if the pin goes LOW
   else _LED_ON = HIGH;
 }
 
 bool BasicLed::ledIsOn(void){
-  if (digitalRead(_pin) == _LED_ON) return true;
+  if (_pin.read() == _LED_ON) return true;
     else return false;
 }
 
 void BasicLed::turn_on(void){
-  digitalWrite(_pin, _LED_ON);
+  _pin.write(_LED_ON);
 }
 
 void BasicLed::turn_off(void){
-  digitalWrite(_pin, !_LED_ON);
+  _pin.write(!_LED_ON);
 }
 
 void BasicLed::toggle(void){
@@ -0,0 +1,250 @@
+//*****************************************************************************************************
+//
+// File:      DccOneShot.cpp
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//            2026/10/18 AP Version 1.1 Hardware timer only if DCC_CORE_ONESHOT is set
+//            2026/10/18 AP Version 1.2 Without hardware timer, callbacks run with interrupts enabled
+//
+// Purpose:   One-shot timers with microsecond resolution, driven by a hardware timer
+//
+// All running timers are registered in the oneShots table. The hardware timer is always
+// programmed for the earliest deadline of all armed timers, but never further ahead than the
+// hardware allows (maxSpan). The interrupt service routine calls service(), which:
+// 1) calls the callbacks of all timers that have reached their deadline. Deferred timers are
+//    only marked as fired; their callback is called later by update().
+// 2) reprograms the hardware for the next deadline, or stops the hardware if no timer is armed.
+// Since a callback may start or stop other timers, the next deadline is only determined after
+// all callbacks have been called.
+// Without hardware timer, service() is called by update() from the main loop. All timers are then
+// handled as deferred timers: service() only marks them as fired, and update() calls their
+// callbacks. The DCC and RS-Bus interrupts are therefore never blocked during a callback.
+//
+// Hardware details:
+// - Traditional ATMega: Timer1 runs free with prescaler 8. OCR1A is set to TCNT1 + ticks.
+// - MegaAVR / DA / DB: TCB1 in periodic interrupt mode, started from 0 with CCMP = ticks.
+// To avoid missing a compare match that is programmed too close to the current counter value,
+// a minimum number of ticks (minTicks) is used.
+//
+//*****************************************************************************************************
+#include <Arduino.h>
+#include "AP_DccOneShot.h"
+
+static DccOneShot *oneShots[maxOneShots];     // Timers that are armed or fired (deferred)
+static volatile bool deferredPending;         // A deferred timer has fired
+static bool hardwareReady;                    // Has the hardware timer been initialised?
+
+#define ticksPerUs      (F_CPU / 1000000UL)   // CPU clock ticks per microsecond
+
+
+//*****************************************************************************************************
+// Hardware specific functions
+//*****************************************************************************************************
+#if DCC_CORE_ONESHOT && defined(TCCR1B) && defined(OCR1A)
+// Traditional ATMega processors: Timer1, compare channel A, prescaler 8
+#if defined(TIMSK1)
+  #define oneShotMask   TIMSK1
+  #define oneShotFlags  TIFR1
+#else
+  #define oneShotMask   TIMSK                 // ATMega16
+  #define oneShotFlags  TIFR
+#endif
+const unsigned long maxSpan = 65535UL * 8 / ticksPerUs;
+const uint16_t minTicks = 16;
+
+static void hwInit(void) {
+  TCCR1A = 0;                                 // Normal mode
+  TCCR1B = (1 << CS11);                       // Prescaler 8
+}
+
+static void hwArm(unsigned long us) {
+  uint16_t ticks = (us * ticksPerUs) / 8;
+  if (ticks < minTicks) ticks = minTicks;
+  OCR1A = TCNT1 + ticks;
+  oneShotFlags = (1 << OCF1A);                // Clear a pending compare match
+  oneShotMask |= (1 << OCIE1A);
+}
+
+static void hwDisarm(void) {
+  oneShotMask &= ~(1 << OCIE1A);
+}
+
+ISR(TIMER1_COMPA_vect) {
+  DccOneShot::service();
+}
+
+#elif DCC_CORE_ONESHOT && defined(TCB1)
+// MegaAVR and DA/DB processors: TCB1, clock is CPU clock / 2
+#define oneShotTCB      TCB1
+#define oneShotTCB_vect TCB1_INT_vect
+#if defined(TCB_CLKSEL_DIV2_gc)
+  #define oneShotClock  TCB_CLKSEL_DIV2_gc    // DxCore naming
+#else
+  #define oneShotClock  TCB_CLKSEL_CLKDIV2_gc // MegaCoreX naming
+#endif
+const unsigned long maxSpan = 65535UL * 2 / ticksPerUs;
+const uint16_t minTicks = 8;
+
+static void hwInit(void) {
+  oneShotTCB.CTRLB = TCB_CNTMODE_INT_gc;      // Periodic interrupt mode
+}
+
+static void hwArm(unsigned long us) {
+  uint16_t ticks = (us * ticksPerUs) / 2;
+  if (ticks < minTicks) ticks = minTicks;
+  oneShotTCB.CTRLA = 0;
+  oneShotTCB.CNT = 0;
+  oneShotTCB.CCMP = ticks;
+  oneShotTCB.INTFLAGS = TCB_CAPT_bm;
+  oneShotTCB.INTCTRL = TCB_CAPT_bm;
+  oneShotTCB.CTRLA = oneShotClock | TCB_ENABLE_bm;
+}
+
+static void hwDisarm(void) {
+  oneShotTCB.INTCTRL = 0;
+  oneShotTCB.CTRLA = 0;
+}
+
+ISR(oneShotTCB_vect) {
+  oneShotTCB.INTFLAGS = TCB_CAPT_bm;
+  DccOneShot::service();
+}
+
+#else
+// No hardware timer (or DCC_CORE_ONESHOT is 0): deadlines are checked by update()
+#define oneShotPolling
+const unsigned long maxSpan = 0xFFFFFFFF;
+static void hwInit(void) {}
+static void hwArm(unsigned long) {}
+static void hwDisarm(void) {}
+#endif
+
+
+// Start() and stop() may also be called from a callback (thus from the ISR). Therefore the
+// previous interrupt state is restored, instead of enabling interrupts. Without hardware timer
+// there is no ISR, so nothing needs to be protected.
+#if defined(oneShotPolling)
+  #define enterCritical()
+  #define leaveCritical()
+#else
+  #define enterCritical()   uint8_t oldSREG = SREG; noInterrupts()
+  #define leaveCritical()   SREG = oldSREG
+#endif
+
+
+//*****************************************************************************************************
+// Scheduling. Should be called with interrupts disabled
+//*****************************************************************************************************
+void DccOneShot::reschedule(unsigned long now) {
+  bool anyArmed = false;
+  unsigned long next = maxSpan;
+  for (uint8_t i = 0; i < maxOneShots; i++) {
+    DccOneShot *timer = oneShots[i];
+    if (timer && (timer->_state == armed)) {
+      anyArmed = true;
+      long remain = (long)(timer->_deadline - now);
+      if (remain < 0) remain = 0;
+      if ((unsigned long)remain < next) next = remain;
+    }
+  }
+  if (anyArmed) hwArm(next);
+  else hwDisarm();
+}
+
+
+void DccOneShot::service(void) {
+  unsigned long now = micros();
+  for (uint8_t i = 0; i < maxOneShots; i++) {
+    DccOneShot *timer = oneShots[i];
+    if (timer && (timer->_state == armed) && ((long)(timer->_deadline - now) <= 0)) {
+      if (timer->_deferred) {
+        timer->_state = fired;
+        deferredPending = true;
+      }
+      else {
+        timer->_state = idle;
+        oneShots[i] = 0;
+        if (timer->_callback) timer->_callback();
+      }
+    }
+  }
+  reschedule(micros());
+}
+
+
+//*****************************************************************************************************
+// Public methods
+//*****************************************************************************************************
+bool DccOneShot::start(unsigned long us, oneShotCallback_t callback, bool deferred) {
+  enterCritical();
+  if (!hardwareReady) {
+    hwInit();
+    hardwareReady = true;
+  }
+  // Use our existing entry in the table (restart), otherwise a free entry
+  int8_t entry = -1;
+  for (uint8_t i = 0; i < maxOneShots; i++) if (oneShots[i] == this) entry = i;
+  if (entry < 0) {
+    for (uint8_t i = 0; i < maxOneShots; i++) {
+      if (oneShots[i] == 0) {
+        entry = i;
+        break;
+      }
+    }
+  }
+  if (entry < 0) {
+    leaveCritical();
+    return false;
+  }
+  oneShots[entry] = this;
+  _callback = callback;
+  #if defined(oneShotPolling)
+    _deferred = true;                         // All callbacks are called from update()
+  #else
+    _deferred = deferred;
+  #endif
+  _deadline = micros() + us;
+  _state = armed;
+  reschedule(micros());
+  leaveCritical();
+  return true;
+}
+
+
+void DccOneShot::stop(void) {
+  enterCritical();
+  for (uint8_t i = 0; i < maxOneShots; i++) if (oneShots[i] == this) oneShots[i] = 0;
+  _state = idle;
+  reschedule(micros());
+  leaveCritical();
+}
+
+
+bool DccOneShot::running(void) {
+  return (_state == armed);
+}
+
+
+void DccOneShot::update(void) {
+  #if defined(oneShotPolling)
+    service();                                // Only marks the expired timers as fired
+  #endif
+  if (!deferredPending) return;
+  deferredPending = false;
+  for (uint8_t i = 0; i < maxOneShots; i++) {
+    // Only the table access is protected; the callback runs with the caller's interrupt state
+    DccOneShot *timer;
+    bool due;
+    {
+      enterCritical();
+      timer = oneShots[i];
+      due = (timer && (timer->_state == fired));
+      if (due) {
+        timer->_state = idle;
+        oneShots[i] = 0;
+      }
+      leaveCritical();
+    }
+    if (due && timer->_callback) timer->_callback();
+  }
+}
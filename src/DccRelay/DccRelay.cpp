@@ -4,58 +4,194 @@
 // author:    Aiko Pras
 // history:   2022-05-25 V1.0 ap: Initial version
 //            2022-07-17 V1.1 ap: changed to replace the timer library
+//            2026-10-18 V1.2 ap: commands received while a coil is active are remembered
+//            2026-10-18 V1.3 ap: optional coil scheduler, to limit the number of active coils
+//            2026-10-18 V1.4 ap: optional persistent position (DccStateStore)
+//            2026-10-18 V1.5 ap: PWM hold and mono-stable relays
+//            2026-10-18 V1.6 ap: direct port access for the coil pins (DccFastPin)
+//            2026-10-18 V1.7 ap: activate() first handles an expired hold time
+//            2026-10-18 V1.8 ap: the scheduler is only released for a coil it granted
 //
 // purpose:   Functions for a bi-stable relay (or a switch)
 //
-// Despite the fact that they are slow, we use standard Arduino digitalWrite() functions.
-// MegaCoreX and DxCore also provide a digitalWriteFast() variant, but such variant requires the pin
-// to be constant and known at compile time. Although that could be done for various decoders, having
-// constants for the pin numbers is not feasable in case of a generic library.
+// The coil pins are switched via DccFastPin objects, which look up the port and bit of the pin once,
+// in init(). MegaCoreX and DxCore also provide a digitalWriteFast() variant, but such variant requires
+// the pin to be constant and known at compile time. Although that could be done for various decoders,
+// having constants for the pin numbers is not feasable in case of a generic library.
+// digitalWrite() is still used to end a PWM hold, since it also disconnects the timer from the pin.
+//
+// While a coil is active, the relay can not be switched to the other position. Previously such
+// commands were ignored, so that a PC route that flips a turnout twice within the hold time lost
+// its second command. Now the command is stored in _pending, and executed by update() once the
+// coil has been switched off. Only the latest command is remembered:
+// - if a pending command is replaced by a newer command, "coalesced" is incremented.
+// - if the newer command requests the position the relay is already moving to, the pending
+//   command is no longer needed and cancelled; "dropped" is incremented.
+//
+// If a DccCoilScheduler is used, a command first waits (_waiting) till the scheduler calls grant().
+// While waiting, the requested position is stored in _pending, thus is handled in the same way as
+// a command received while the coil is active.
+//
+// If a DccStateStore is used, init() takes the position from the store. Since the relays are
+// bi-stable, they are still in that position after a power cycle, so no coil is activated.
+// switchCoil() hands each new position to the store, which writes it later to EEPROM.
+//
+// PWM hold: holdTime is now the full power pull-in phase. Once it has passed, the coil gets an
+// analogWrite() with the hold duty cycle, so the PWM signal is generated by the hardware timer
+// that belongs to the pin, and not by toggling the pin from the main loop. The hold ends once
+// the relay is switched to the other position; digitalWrite() then also stops the PWM output.
+// The coil scheduler is released after the pull-in phase, since only that phase draws full
+// current. Only a coil that was granted by the scheduler (_granted) releases it: the mono-stable
+// relay that init() energises, or a coil activated before useScheduler(), was never counted.
+// A mono-stable relay (pinPos1 == pinPos2) is energised for POS2 and released for POS1. For POS1
+// no coil is activated, thus no hold time is needed. Without PWM hold, the coil of a mono-stable
+// relay stays at full power.
 //
 //******************************************************************************************************
 #include <Arduino.h>
 #include "AP_DccRelay.h"
+#include "AP_DccCoilScheduler.h"
+#include "AP_DccStateStore.h"
+#include "AP_DccTrace.h"
 
-void relayClass::init(uint8_t pinPos1, uint8_t pinPos2, uint8_t holdTime) {
+void relayClass::init(uint8_t pinPos1, uint8_t pinPos2, uint8_t holdTime,
+                      DccStateStore *store, uint8_t index) {
   _pinPos1 = pinPos1;
   _pinPos2 = pinPos2;
-  pinMode(_pinPos1, OUTPUT);
-  pinMode(_pinPos2, OUTPUT);
+  _coil1.attach(_pinPos1);
+  _coil2.attach(_pinPos2);
   relayTimer.runTime = holdTime * 20;         // holdTime is in 20ms steps
   state = UNKNOWN;
+  _store = store;
+  _storeIndex = index;
+  if (_store != nullptr) {
+    uint8_t stored = _store->get(_storeIndex);
+    if (stored == POS1) state = POS1;
+    if (stored == POS2) state = POS2;
+  }
+  _pending = UNKNOWN;
+  coalesced = 0;
+  dropped = 0;
+  // A mono-stable relay loses its position without power, thus should be energised again
+  if ((_pinPos1 == _pinPos2) && (state == POS2)) switchCoil(POS2);
+}
+
+
+void relayClass::useScheduler(DccCoilScheduler *scheduler, uint8_t priority) {
+  _scheduler = scheduler;
+  _priority = priority;
+}
+
+
+void relayClass::setPwmHold(uint8_t duty) {
+  _pwmDuty = duty;
+}
+
+
+void relayClass::coilOff(rState_t position) {
+  if (_pwmDuty > 0) digitalWrite((position == POS1) ? _pinPos1 : _pinPos2, LOW);   // Ends PWM
+  else if (position == POS1) _coil1.low();
+  else _coil2.low();
+}
+
+
+bool relayClass::switchCoil(rState_t newState) {
+  state = newState;
+  if (_store != nullptr) _store->set(_storeIndex, newState);
+  dccTrace(traceRelay, _pinPos1, newState);
+  if (_pinPos1 == _pinPos2) {
+    // Mono-stable relay
+    if (newState == POS1) {
+      coilOff(POS1);
+      return false;
+    }
+    relayTimer.start();
+    _coil2.high();
+    return true;
+  }
+  relayTimer.start();                         // Start the timer, to allow later deactivation
+  if (newState == POS1) {
+    coilOff(POS2);                            // Ends a PWM hold of the other coil
+    _coil1.high();
+  }
+  else {
+    coilOff(POS1);
+    _coil2.high();
+  }
+  return true;
+}
+
+
+void relayClass::endPullIn() {
+  // The pull-in phase has passed: hold the coil with PWM, or switch it off
+  if (_pwmDuty > 0) analogWrite((state == POS1) ? _pinPos1 : _pinPos2, _pwmDuty);   // Hold
+  else if (_pinPos1 != _pinPos2) coilOff(state);
+  if (_granted) {
+    _granted = false;
+    _scheduler->release();
+  }
 }
 
 
 void relayClass::activate(rState_t newState) {
-  switch (newState) {
-    case POS1:
-      if (state != POS1) {
-        if (relayTimer.running() == false) {
-          relayTimer.start();                 // Start the timer, to allow later deactivation
-          digitalWrite(_pinPos1, HIGH);
-          state = POS1;
-        }
-      };
-    break;
-    case POS2:
-      if (state != POS2) {
-        if (relayTimer.running() == false) {
-          relayTimer.start();                 // Start the timer, to allow later deactivation
-          digitalWrite(_pinPos2, HIGH);
-          state = POS2;
-        }
-      };
-    break;
-    case UNKNOWN:
-    break;
+  if (newState == UNKNOWN) return;
+  // running() becomes false once the hold time has passed, even if update() did not yet handle
+  // the expiry. The active coil should then first be switched off, and the scheduler released,
+  // before the new command is handled. A pending command is replaced by the new command.
+  if (relayTimer.expired()) {
+    endPullIn();
+    if (_pending != UNKNOWN) {
+      coalesced++;
+      _pending = UNKNOWN;
+    }
+  }
+  if (relayTimer.running() || _waiting) {
+    // A coil is still active, or we wait for the scheduler.
+    // Remember the command, unless it is no longer needed
+    if (_pending != UNKNOWN) {
+      if (newState == state) dropped++;
+      else coalesced++;
+    }
+    _pending = (newState == state) ? UNKNOWN : newState;
+    if (_waiting && (_pending == UNKNOWN)) {
+      _waiting = false;
+      _scheduler->cancel(this);
+    }
+    return;
+  }
+  if (newState == state) return;
+  if (_scheduler != nullptr) {
+    _pending = newState;
+    _waiting = true;                          // Should be set before request() may call grant()
+    if (!_scheduler->request(this, _priority)) {
+      _waiting = false;
+      _pending = UNKNOWN;
+      dropped++;                              // Scheduler queue is full
+    }
+    return;
   }
+  switchCoil(newState);
+}
+
+
+bool relayClass::grant() {
+  _waiting = false;
+  rState_t next = _pending;
+  _pending = UNKNOWN;
+  if ((next == UNKNOWN) || (next == state)) return false;
+  _granted = switchCoil(next);
+  return _granted;
 }
 
 
 void relayClass::update() {
   if (relayTimer.expired()) {
-    if (state == POS1) {digitalWrite(_pinPos1, LOW);}
-    if (state == POS2) {digitalWrite(_pinPos2, LOW);}
+    endPullIn();
+    if (_pending != UNKNOWN) {
+      rState_t next = _pending;
+      _pending = UNKNOWN;
+      activate(next);
+    }
   }
 }
 
@@ -0,0 +1,210 @@
+//******************************************************************************************************
+//
+// file:      DccRelayBank.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//            2026-10-18 V1.1 ap: pulse() is limited to maxRelayPulse (32767 ms)
+//            2026-10-18 V1.2 ap: DccRoundRobin::command() takes on / off (the DCC position)
+//
+// purpose:   Bank of 16 (mono-stable) relays, connected to two 8 bit output ports.
+//
+// All changes are first made to _state; commit() then writes both ports. Since all 8 bits of
+// both ports are used for relays, each port is written with a single store; no read-modify-write
+// is needed. Both stores are performed with interrupts disabled, so that the two halves of the
+// bank change together.
+//
+// Deadlines are stored as the lower 16 bits of millis(). Expiry is tested with
+// (int16_t)(now - due) >= 0, which is correct for pulses up to 32767 ms. Longer pulses would
+// be seen as expired immediately, so pulse() shortens them to maxRelayPulse.
+// If all entries of the deadline table are in use, the relays are added to the entry with the
+// latest deadline. The deadline of that entry is moved forward if needed, so relays are never
+// switched off before the requested time.
+//
+// DccRoundRobin: all changes go via apply(), which compares the state of the bank before and
+// after the change, and calls the callback if relays changed.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include "AP_DccRelayBank.h"
+
+// Port writes are made with interrupts disabled. On AVR the previous interrupt state is restored
+// afterwards; other architectures (Arduino API shims) have no status register.
+#if defined(__AVR__)
+  #define enterCritical()   uint8_t oldSREG = SREG; noInterrupts()
+  #define leaveCritical()   SREG = oldSREG
+#else
+  #define enterCritical()   noInterrupts()
+  #define leaveCritical()   interrupts()
+#endif
+
+
+void DccRelayBank::attach(uint8_t pinRelay1, uint8_t pinRelay9, bool activeHigh) {
+  _port1 = portOutputRegister(digitalPinToPort(pinRelay1));
+  _port2 = portOutputRegister(digitalPinToPort(pinRelay9));
+  _polarity = activeHigh ? 0x0000 : 0xFFFF;
+  _state = 0;
+  for (uint8_t i = 0; i < maxRelayDeadlines; i++) _deadline[i].mask = 0;
+  commit();                                   // All relays off, before the ports become outputs
+  enterCritical();
+  *portModeRegister(digitalPinToPort(pinRelay1)) = 0xFF;
+  *portModeRegister(digitalPinToPort(pinRelay9)) = 0xFF;
+  leaveCritical();
+}
+
+
+void DccRelayBank::commit() {
+  uint16_t out = _state ^ _polarity;
+  enterCritical();
+  *_port1 = out & 0xFF;
+  *_port2 = out >> 8;
+  leaveCritical();
+}
+
+
+void DccRelayBank::cancelPulse(uint16_t mask) {
+  for (uint8_t i = 0; i < maxRelayDeadlines; i++) _deadline[i].mask &= ~mask;
+}
+
+
+void DccRelayBank::on(uint8_t relay) {
+  change(1 << relay, 0);
+}
+
+
+void DccRelayBank::off(uint8_t relay) {
+  change(0, 1 << relay);
+}
+
+
+void DccRelayBank::set(uint16_t mask) {
+  cancelPulse(0xFFFF);
+  _state = mask;
+  commit();
+}
+
+
+void DccRelayBank::change(uint16_t onMask, uint16_t offMask) {
+  cancelPulse(onMask | offMask);
+  uint16_t newState = (_state | onMask) & ~offMask;
+  if (newState == _state) return;
+  _state = newState;
+  commit();
+}
+
+
+void DccRelayBank::pulse(uint16_t mask, uint16_t ms) {
+  change(mask, 0);
+  if (ms > maxRelayPulse) ms = maxRelayPulse;
+  uint16_t due = (uint16_t)millis() + ms;
+  // Find an entry with the same deadline, or a free entry
+  uint8_t freeEntry = maxRelayDeadlines;
+  uint8_t latest = 0;
+  for (uint8_t i = 0; i < maxRelayDeadlines; i++) {
+    deadline_t &entry = _deadline[i];
+    if (entry.mask == 0) {
+      if (freeEntry == maxRelayDeadlines) freeEntry = i;
+      continue;
+    }
+    if (entry.due == due) {
+      entry.mask |= mask;
+      return;
+    }
+    if ((int16_t)(entry.due - _deadline[latest].due) > 0) latest = i;
+  }
+  if (freeEntry < maxRelayDeadlines) {
+    _deadline[freeEntry].mask = mask;
+    _deadline[freeEntry].due = due;
+    return;
+  }
+  // Table full: share the entry with the latest deadline
+  deadline_t &entry = _deadline[latest];
+  entry.mask |= mask;
+  if ((int16_t)(due - entry.due) > 0) entry.due = due;
+}
+
+
+bool DccRelayBank::isOn(uint8_t relay) {
+  return (_state >> relay) & 1;
+}
+
+
+void DccRelayBank::update() {
+  uint16_t now = millis();                    // millis() is called once per update
+  uint16_t offMask = 0;
+  for (uint8_t i = 0; i < maxRelayDeadlines; i++) {
+    deadline_t &entry = _deadline[i];
+    if (entry.mask && ((int16_t)(now - entry.due) >= 0)) {
+      offMask |= entry.mask;
+      entry.mask = 0;
+    }
+  }
+  if (offMask == 0) return;
+  _state &= ~offMask;
+  commit();
+}
+
+
+//******************************************************************************************************
+// DccRoundRobin
+//******************************************************************************************************
+void DccRoundRobin::attach(DccRelayBank *bank, uint8_t mode, uint16_t rrMask, uint8_t interval,
+                           changeCallback_t onChange) {
+  _bank = bank;
+  _mode = mode;
+  _rrMask = rrMask;
+  _interval = interval * 1000UL;
+  _onChange = onChange;
+  _current = 15;                              // such that the first step selects the lowest relay
+  _lastStep = millis();
+  if ((_mode == 3) && _interval && _rrMask) step();
+}
+
+
+void DccRoundRobin::apply(uint16_t onMask, uint16_t offMask) {
+  uint16_t oldState = _bank->state();
+  _bank->change(onMask, offMask);
+  uint16_t changed = oldState ^ _bank->state();
+  if (changed && _onChange) _onChange(_bank->state(), changed);
+}
+
+
+void DccRoundRobin::command(uint8_t relay, bool on) {
+  if (relay > 15) return;
+  uint16_t bit = 1 << relay;
+  switch (_mode) {
+    case 0:
+      if (on) apply(bit, ~bit);
+    break;
+    case 1:
+      if (on) apply(bit, ~bit);
+      else apply(0, bit);
+    break;
+    case 3:
+      if (_rrMask & bit) return;              // Controlled by the round-robin
+      // fall through
+    default:
+      if (on) apply(bit, 0);
+      else apply(0, bit);
+    break;
+  }
+}
+
+
+void DccRoundRobin::step() {
+  uint8_t next = _current;
+  do {
+    next = (next + 1) & 0x0F;
+  } while (!(_rrMask & (1 << next)));
+  _current = next;
+  uint16_t bit = 1 << next;
+  apply(bit, _rrMask & ~bit);
+}
+
+
+void DccRoundRobin::update() {
+  if ((_mode != 3) || (_interval == 0) || (_rrMask == 0)) return;
+  unsigned long now = millis();
+  if (now - _lastStep < _interval) return;
+  _lastStep = now;
+  step();
+}
@@ -0,0 +1,82 @@
+//*****************************************************************************************************
+//
+// File:      DccSignalQuality.cpp
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   Rolling window statistics of DCC and RS-Bus errors
+//
+// The error counters are 8 bit and wrap around. The number of new errors is therefore calculated
+// as an 8 bit difference, which is correct as long as there are less than 256 errors per second.
+// The rolling window keeps a running sum: the oldest second is subtracted, the newest added.
+//
+//*****************************************************************************************************
+#include "AP_DCC_Decoder_Core.h"
+#include "AP_DccSignalQuality.h"
+
+extern RSbusHardware rsbusHardware;
+
+
+//*****************************************************************************************************
+// DccErrorStats
+//*****************************************************************************************************
+void DccErrorStats::init(uint8_t counter) {
+  _counter = counter;
+  for (uint8_t i = 0; i < qualityWindows; i++) _ring[i] = 0;
+  _head = 0;
+  _sum = 0;
+  _peak = 0;
+  _age = 255;
+}
+
+
+void DccErrorStats::sample(uint8_t counter) {
+  uint8_t errors = counter - _counter;
+  _counter = counter;
+  _head = (_head + 1) & (qualityWindows - 1);
+  _sum = _sum - _ring[_head] + errors;
+  _ring[_head] = errors;
+  if (errors > _peak) _peak = errors;
+  if (errors) _age = 0;
+  else if (_age < 255) _age++;
+}
+
+
+//*****************************************************************************************************
+// DccSignalQuality
+//*****************************************************************************************************
+void DccSignalQuality::init(void) {
+  dccSignal.init(dcc.errorXOR);
+  rsParity.init(rsbusHardware.parityErrors);
+  rsPulse.init(rsbusHardware.pulseCountErrors);
+  _lastSample = millis();
+}
+
+
+void DccSignalQuality::update(unsigned long now) {
+  if ((now - _lastSample) < 1000) return;
+  _lastSample += 1000;
+  dccSignal.sample(dcc.errorXOR);
+  rsParity.sample(rsbusHardware.parityErrors);
+  rsPulse.sample(rsbusHardware.pulseCountErrors);
+}
+
+
+static uint8_t tenMs(unsigned long ms) {
+  return (ms >= 2550) ? 255 : (ms / 10);
+}
+
+
+uint8_t DccSignalQuality::read(unsigned int number) {
+  if (!isDiagnosticCv(number)) return 0;
+  uint8_t offset = number - diagnosticCvs;
+  if (offset == 12) return tenMs(decoderHardware.readyTime);
+  if (offset == 13) return decoderHardware.answerTime ? tenMs(decoderHardware.answerTime) : 0;
+  DccErrorStats &stats = (offset < 4) ? dccSignal : (offset < 8) ? rsParity : rsPulse;
+  switch (offset & 3) {
+    case 0: return stats.lastSecond();
+    case 1: return stats.window();
+    case 2: return stats.peak();
+    default: return stats.age();
+  }
+}
@@ -0,0 +1,107 @@
+//******************************************************************************************************
+//
+// file:      DccStateStore.cpp
+// author:    Aiko Pras
+// history:   2026-10-18 V1.0 ap: Initial version
+//
+// purpose:   Stores relay / turnout positions in EEPROM, such that they survive a power cycle.
+//
+// Records are written with increasing sequence numbers, in increasing record order. The most
+// recent record is therefore a valid record that is not followed by a valid record with the next
+// sequence number. Since less than 256 records are used, this also works after the (8 bit)
+// sequence number wraps around.
+//
+// Within a record the check byte is written last. Since the check byte covers the sequence
+// number and all positions, a record that was not completely written will be ignored at startup.
+//
+// Writing an EEPROM byte takes some 3.3ms. EEPROM.update() waits till the previous write has
+// finished, but returns once the new write has started. By writing a single byte per call of
+// update(), and only if the EEPROM is ready, update() does not wait.
+//
+//******************************************************************************************************
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "AP_DccStateStore.h"
+
+#define seqByte     (storedRecordSize - 2)
+#define checkByte   (storedRecordSize - 1)
+
+
+uint8_t DccStateStore::check(const uint8_t *record) {
+  uint8_t sum = 0x5A;
+  for (uint8_t i = 0; i < checkByte; i++) sum = (sum << 1 | sum >> 7) ^ record[i];
+  return sum;
+}
+
+
+void DccStateStore::attach(uint16_t start, uint16_t size, uint16_t delay) {
+  _start = start;
+  uint16_t records = size / storedRecordSize;
+  _records = (records > 255) ? 255 : records;
+  _delay = delay;
+  _dirty = false;
+  _writePos = storedRecordSize;
+  // Search the most recent valid record
+  bool found = false;
+  uint8_t record[storedRecordSize];
+  uint8_t next[storedRecordSize];
+  for (uint8_t r = 0; (r < _records) && !found; r++) {
+    uint16_t address = _start + (r * storedRecordSize);
+    for (uint8_t i = 0; i < storedRecordSize; i++) record[i] = EEPROM.read(address + i);
+    if (check(record) != record[checkByte]) continue;
+    uint8_t n = (r + 1 < _records) ? r + 1 : 0;
+    address = _start + (n * storedRecordSize);
+    for (uint8_t i = 0; i < storedRecordSize; i++) next[i] = EEPROM.read(address + i);
+    if ((_records > 1) && (check(next) == next[checkByte]) && (next[seqByte] == (uint8_t)(record[seqByte] + 1))) continue;
+    found = true;
+    _current = r;
+    _seq = record[seqByte];
+    for (uint8_t i = 0; i < storedBytes; i++) _positions[i] = record[i];
+  }
+  if (!found) {
+    _current = (_records > 0) ? _records - 1 : 0;   // Start writing at record 0
+    _seq = 0xFF;
+    for (uint8_t i = 0; i < storedBytes; i++) _positions[i] = 0xFF;
+  }
+}
+
+
+uint8_t DccStateStore::get(uint8_t index) {
+  if (index >= maxStoredPositions) return 0x03;
+  return (_positions[index >> 2] >> ((index & 0x03) * 2)) & 0x03;
+}
+
+
+void DccStateStore::set(uint8_t index, uint8_t value) {
+  if (index >= maxStoredPositions) return;
+  if (get(index) == (value & 0x03)) return;
+  uint8_t shift = (index & 0x03) * 2;
+  uint8_t &pos = _positions[index >> 2];
+  pos = (pos & ~(0x03 << shift)) | ((value & 0x03) << shift);
+  _dirty = true;
+  _lastChange = millis();
+}
+
+
+void DccStateStore::update() {
+  if (_records == 0) return;
+  if (_writePos < storedRecordSize) {
+    // A record is being written. Write the next byte, if the EEPROM is ready
+    #if defined(eeprom_is_ready)
+      if (!eeprom_is_ready()) return;
+    #endif
+    EEPROM.update(_start + (_current * storedRecordSize) + _writePos, _record[_writePos]);
+    _writePos++;
+    return;
+  }
+  if (!_dirty) return;
+  if (millis() - _lastChange < _delay) return;
+  // Start writing a new record, with a copy of the current positions
+  _dirty = false;
+  _current = (_current + 1 < _records) ? _current + 1 : 0;
+  _seq++;
+  for (uint8_t i = 0; i < storedBytes; i++) _record[i] = _positions[i];
+  _record[seqByte] = _seq;
+  _record[checkByte] = check(_record);
+  _writePos = 0;
+}
@@ -75,13 +75,21 @@ unsigned long DccTimer::getRuntime() {
   return runTime;
 }
 
+// getElapsed() and getRemain() read millis() only once, instead of once in running()
+// and once more for the calculation.
 unsigned long DccTimer::getElapsed() {
-  if (running()) return ((millis() - startTime) + 1);
-  else return runTime;
+  if (notExpired) {
+    unsigned long elapsed = millis() - startTime;
+    if (elapsed < runTime) return (elapsed + 1);
+  }
+  return runTime;
 }
 
 unsigned long DccTimer::getRemain() {
-  if (running()) return (runTime - (millis() - startTime));
-  else return false;
+  if (notExpired) {
+    unsigned long elapsed = millis() - startTime;
+    if (elapsed < runTime) return (runTime - elapsed);
+  }
+  return false;
 }
 
@@ -0,0 +1,124 @@
+//*****************************************************************************************************
+//
+// File:      DccTimerWheel.cpp
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   Timer service for decoders that need many timers
+//
+// The timers are stored in singly linked lists: one list per bucket, plus one list with timers
+// that have expired, but of which the callback has not been called yet. The "where" field of
+// each timer tells in which list the timer is stored, so that stop() and start() only need to
+// walk a single (short) list.
+//
+// update() first moves all expired timers of the current bucket to the expired list, and only
+// then calls the callbacks. Since no callback is called while the bucket list is being walked,
+// callbacks may safely start or stop any timer, including their own.
+//
+//*****************************************************************************************************
+#include <Arduino.h>
+#include "AP_DccTimerWheel.h"
+
+// Possible values for "where", next to the bucket number (0..wheelSize-1)
+#define inExpiredList   0xFE
+#define notRunning      0xFF
+
+
+void DccTimerWheel::attach(DccWheelSlot *slots, uint8_t count, uint8_t tickTime) {
+  _slots = slots;
+  _count = count;
+  _used = 0;
+  _tickTime = (tickTime > 0) ? tickTime : 1;
+  _cursor = 0;
+  _expired = noTimer;
+  for (uint8_t i = 0; i < wheelSize; i++) _bucket[i] = noTimer;
+  _lastTick = millis();
+}
+
+
+uint8_t DccTimerWheel::create(wheelCallback_t callback) {
+  if (_used >= _count) return noTimer;
+  DccWheelSlot &slot = _slots[_used];
+  slot.callback = callback;
+  slot.where = notRunning;
+  slot.next = noTimer;
+  return _used++;
+}
+
+
+void DccTimerWheel::unlink(uint8_t handle) {
+  uint8_t where = _slots[handle].where;
+  if (where == notRunning) return;
+  uint8_t *link = (where == inExpiredList) ? &_expired : &_bucket[where];
+  while (*link != noTimer) {
+    if (*link == handle) {
+      *link = _slots[handle].next;
+      break;
+    }
+    link = &_slots[*link].next;
+  }
+  _slots[handle].where = notRunning;
+}
+
+
+void DccTimerWheel::start(uint8_t handle, unsigned long ms) {
+  if (handle >= _used) return;
+  unlink(handle);
+  // The timer should not expire too early. Ticks are counted from the last tick, thus the
+  // time that has passed since then is added. Rounding down is compensated by one extra tick.
+  unsigned long ticks = ((ms + (millis() - _lastTick)) / _tickTime) + 1;
+  uint8_t bucket = (_cursor + ticks) & (wheelSize - 1);
+  unsigned long rounds = (ticks - 1) / wheelSize;
+  DccWheelSlot &slot = _slots[handle];
+  slot.rounds = (rounds > 0xFFFF) ? 0xFFFF : rounds;
+  slot.where = bucket;
+  slot.next = _bucket[bucket];
+  _bucket[bucket] = handle;
+}
+
+
+void DccTimerWheel::stop(uint8_t handle) {
+  if (handle >= _used) return;
+  unlink(handle);
+}
+
+
+bool DccTimerWheel::running(uint8_t handle) {
+  if (handle >= _used) return false;
+  uint8_t where = _slots[handle].where;
+  return (where < wheelSize);
+}
+
+
+void DccTimerWheel::update(void) {
+  unsigned long now = millis();                 // millis() is called once per update
+  while ((now - _lastTick) >= _tickTime) {
+    _lastTick += _tickTime;
+    _cursor = (_cursor + 1) & (wheelSize - 1);
+    // Step 1: walk the bucket. Move expired timers to the expired list
+    uint8_t handle = _bucket[_cursor];
+    _bucket[_cursor] = noTimer;
+    while (handle != noTimer) {
+      DccWheelSlot &slot = _slots[handle];
+      uint8_t next = slot.next;
+      if (slot.rounds > 0) {
+        slot.rounds--;
+        slot.next = _bucket[_cursor];
+        _bucket[_cursor] = handle;
+      }
+      else {
+        slot.where = inExpiredList;
+        slot.next = _expired;
+        _expired = handle;
+      }
+      handle = next;
+    }
+    // Step 2: call the callbacks. A callback may start or stop timers
+    while (_expired != noTimer) {
+      handle = _expired;
+      _expired = _slots[handle].next;
+      _slots[handle].where = notRunning;
+      if (_slots[handle].callback) _slots[handle].callback(handle);
+    }
+  }
+}
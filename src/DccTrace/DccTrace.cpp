@@ -0,0 +1,104 @@
+//*****************************************************************************************************
+//
+// File:      DccTrace.cpp
+// Author:    Aiko Pras
+// History:   2026/10/18 AP Version 1.0
+//
+// Purpose:   Binary trace buffer for runtime diagnostics
+//
+// log() is the only function that may be called from an ISR; it writes at _head, while update()
+// and dump() read at _tail. One entry is always kept free, so that _head == _tail means empty.
+// Events that arrive while the buffer is full are counted in _lost. Once there is room again,
+// log() first stores a traceLost event, so the lost events appear at the right place in the
+// timeline.
+//
+// A frame is only started if the transmit buffer has room for the complete frame
+// (availableForWrite()), so update() never waits for the UART.
+//
+//*****************************************************************************************************
+#include <Arduino.h>
+#include "AP_DccTrace.h"
+
+#if defined(__AVR__)
+  #define enterCritical()   uint8_t oldSREG = SREG; noInterrupts()
+  #define leaveCritical()   SREG = oldSREG
+#else
+  #define enterCritical()   noInterrupts()
+  #define leaveCritical()   interrupts()
+#endif
+
+#define traceSync       0xA5        // First byte of each frame
+#define traceFrameSize  7
+
+#if DCC_CORE_TRACE
+DccTrace traceBuffer;
+#endif
+
+
+void DccTrace::attach(Print &port) {
+  _port = &port;
+  _head = 0;
+  _tail = 0;
+  _lost = 0;
+}
+
+
+void DccTrace::log(uint8_t id, uint8_t a, uint8_t b) {
+  uint16_t now = millis();
+  enterCritical();
+  uint8_t free = (_tail - _head - 1) & (traceSize - 1);
+  if (_lost && (free >= 2)) {
+    // There is room again: first store how many events were lost
+    store(traceLost, now, _lost, 0);
+    _lost = 0;
+    free--;
+  }
+  if (free == 0) {
+    if (_lost < 255) _lost++;
+  }
+  else store(id, now, a, b);
+  leaveCritical();
+}
+
+
+void DccTrace::store(uint8_t id, uint16_t time, uint8_t a, uint8_t b) {
+  event_t &event = _events[_head];
+  event.id = id;
+  event.time = time;
+  event.a = a;
+  event.b = b;
+  _head = (_head + 1) & (traceSize - 1);
+}
+
+
+void DccTrace::send(const event_t &event) {
+  uint8_t frame[traceFrameSize];
+  frame[0] = traceSync;
+  frame[1] = event.id;
+  frame[2] = event.time & 0xFF;
+  frame[3] = event.time >> 8;
+  frame[4] = event.a;
+  frame[5] = event.b;
+  frame[6] = frame[1] ^ frame[2] ^ frame[3] ^ frame[4] ^ frame[5];
+  _port->write(frame, traceFrameSize);
+}
+
+
+void DccTrace::update(void) {
+  if (_port == nullptr) return;
+  while (_tail != _head) {
+    if (_port->availableForWrite() < traceFrameSize) return;
+    send(_events[_tail]);
+    _tail = (_tail + 1) & (traceSize - 1);
+  }
+}
+
+
+void DccTrace::dump(void) {
+  if (_port == nullptr) return;
+  while (_tail != _head) {
+    send(_events[_tail]);                       // write() waits if the transmit buffer is full
+    _tail = (_tail + 1) & (traceSize - 1);
+  }
+  _port->flush();
+}
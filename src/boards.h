@@ -9,6 +9,8 @@
 //            2021/12/30 AP Version 1.2
 //            2024/05/09 AP Version 1.3: TMC board added
 //            2025/10/10 AP Version 1.4: Servo 2.2 added
+//            2026/10/18 AP Version 1.5: Non-AVR (Arduino API shim) builds
+//            2026/10/18 AP Version 1.6: Compile time check on pin conflicts
 //
 // The code is designed to run on traditional Arduino boards, such as the Nano, Uno and Mega,
 // as well as MiniCore, MightyCore, MegaCore, MegaCoreX and DxCore boards. It has been tested with
@@ -24,6 +26,9 @@
 // - ackPin           - Any Arduino digital pin
 // - swapUsartPin     - MegaX processors allow the USART to be connected to alternative pins
 //
+// Each pin should be used for a single signal only. This is checked at compile time, so a modified
+// pin assignment that uses a pin twice gives an error message, instead of a decoder that fails.
+//
 // Note that the AP_DCC_library uses Timer2 (8bit) or one of the TCBs
 // Make sure the right clock-speed (F_CPU) is selected in the Arduino "Tools->Clock" menu
 //
@@ -149,6 +154,17 @@ const uint8_t ledPin = 4;             // Pin 4 is on the DCC Board; PIN 13 is th
 const uint8_t buttonPin = 6;          // Digital Pin 6 on the Arduino UNO
 const uint8_t ackPin = 7;             // Digital Pin 7 on the Arduino UNO
 
+#elif !defined(__AVR__)
+// Not an AVR processor: the core is compiled against an Arduino API shim (for example for tests
+// or simulation on a PC). The pin numbers are those of the UNO; the shim decides what they mean.
+const uint8_t rsBusUsart = 0;         //
+const bool swapUsartPin = false;      //
+const uint8_t rsBusRX = 2;            //
+const uint8_t dccPin = 3;             //
+const uint8_t ledPin = 4;             //
+const uint8_t buttonPin = 6;          //
+const uint8_t ackPin = 7;             //
+
 #elif defined(AVR_XMEGA) || !defined(MEGACOREX)
 // This is likely the Nano Every, using the "standard" Arduino megaAVR board
 // The onboard USB connector is Serial
@@ -177,3 +193,18 @@ const uint8_t buttonPin = 6;          //
 const uint8_t ackPin = 7;             //
 
 #endif
+
+
+//******************************************************************************************************
+// Pin conflicts
+//******************************************************************************************************
+static_assert(dccPin != rsBusRX,      "boards.h: dccPin and rsBusRX use the same pin");
+static_assert(dccPin != ackPin,       "boards.h: dccPin and ackPin use the same pin");
+static_assert(dccPin != ledPin,       "boards.h: dccPin and ledPin use the same pin");
+static_assert(dccPin != buttonPin,    "boards.h: dccPin and buttonPin use the same pin");
+static_assert(rsBusRX != ackPin,      "boards.h: rsBusRX and ackPin use the same pin");
+static_assert(rsBusRX != ledPin,      "boards.h: rsBusRX and ledPin use the same pin");
+static_assert(rsBusRX != buttonPin,   "boards.h: rsBusRX and buttonPin use the same pin");
+static_assert(ackPin != ledPin,       "boards.h: ackPin and ledPin use the same pin");
+static_assert(ackPin != buttonPin,    "boards.h: ackPin and buttonPin use the same pin");
+static_assert(ledPin != buttonPin,    "boards.h: ledPin and buttonPin use the same pin");
@@ -0,0 +1,81 @@
+//******************************************************************************************************
+//
+// file:      core_features.h
+// Author:    Aiko Pras
+// purpose:   Defines which subsystems of the decoder core are included.
+//
+// History:   2026/10/18 AP Version 1.0
+//
+// By default all subsystems are included. Decoders that do not need a subsystem may exclude it,
+// by changing its value below into 0. An excluded subsystem is removed entirely, so it does not
+// occupy flash or RAM. This is mainly useful for processors with little memory, such as the
+// ATMega16 and the ATMega328 (UNO, Nano).
+// Similar to boards.h, this file should be edited, since the Arduino IDE does not pass settings
+// from the main sketch to libraries. Build systems that do pass compiler flags (such as
+// arduino-cli with --build-property, or PlatformIO with build_flags) may instead define the
+// macros on the command line, for example: -DDCC_CORE_LED=0
+//
+// - DCC_CORE_LED:             the onboard LED (onBoardLed). Without LED, the search function
+//                             (CV23) and the LED signals of the programming button are not available.
+// - DCC_CORE_PROG_BUTTON:     the onboard programming button (address programming and restore of
+//                             the default CV values). Without button, addresses can only be set via
+//                             SM or PoM.
+// - DCC_CORE_POM_FEEDBACK:    feedback on PoM verify commands via RS-Bus address 128 (rsbusPom).
+// - DCC_CORE_CV_PROGRAMMING:  reactions on SM and PoM commands (cvProgramming.processMessage()).
+//                             Without CV programming, the CVs keep their default values, unless
+//                             the sketch changes them. PoM feedback is then also excluded.
+// - DCC_CORE_TRACE:           the binary trace buffer (traceBuffer, see AP_DccTrace.h). Disabled by
+//                             default, since the buffer takes some 160 bytes RAM.
+// - DCC_CORE_DISPATCH:        table driven dispatch of commands to handlers per output
+//                             (commandDispatcher, see AP_DccDispatcher.h).
+// - DCC_CORE_FEEDBACK:        change driven RS-Bus feedback (rsFeedback, see AP_DccFeedback.h).
+// - DCC_CORE_ONESHOT:         hardware timer for DccOneShot (see AP_DccOneShot.h). Disabled by
+//                             default: it defines the compare interrupt of Timer1 (traditional
+//                             ATMega), which conflicts with the Servo library and stops
+//                             analogWrite() on the Timer1 pins, or takes TCB1 (MegaAVR, DA/DB).
+//                             Without hardware timer, DccOneShot callbacks are called from
+//                             DccOneShot::update().
+// - DCC_CORE_QUALITY:         rolling window statistics of DCC and RS-Bus errors, readable via
+//                             PoM as diagnostic CVs (signalQuality, see AP_DccSignalQuality.h).
+//
+// The effect of each setting on flash and RAM usage per board can be determined with
+// extras/footprint.sh.
+//
+//******************************************************************************************************
+#pragma once
+
+#ifndef DCC_CORE_LED
+#define DCC_CORE_LED              1
+#endif
+
+#ifndef DCC_CORE_PROG_BUTTON
+#define DCC_CORE_PROG_BUTTON      1
+#endif
+
+#ifndef DCC_CORE_CV_PROGRAMMING
+#define DCC_CORE_CV_PROGRAMMING   1
+#endif
+
+#ifndef DCC_CORE_POM_FEEDBACK
+#define DCC_CORE_POM_FEEDBACK     DCC_CORE_CV_PROGRAMMING
+#endif
+
+#ifndef DCC_CORE_TRACE
+#define DCC_CORE_TRACE            0
+#endif
+
+#ifndef DCC_CORE_DISPATCH
+#define DCC_CORE_DISPATCH         1
+#endif
+
+#ifndef DCC_CORE_FEEDBACK
+#define DCC_CORE_FEEDBACK         1
+#endif
+
+#ifndef DCC_CORE_QUALITY
+#define DCC_CORE_QUALITY          1
+#endif
+
+#ifndef DCC_CORE_ONESHOT
+#define DCC_CORE_ONESHOT          0
+#endif